@@ -0,0 +1,54 @@
+#ifndef BENCH_COMUM_H
+#define BENCH_COMUM_H
+
+// Utilidades dos benchmarks: relógio monotônico, um gerador barato de
+// posições (bench_grade_espacial não linka o resto do jogo) e a comparação
+// do qsort para tirar medianas. Compile com -D_POSIX_C_SOURCE=199309L.
+
+#ifdef _WIN32
+// windows.h colide com o raylib.h (CloseWindow, Rectangle, DrawText...):
+// declara só as duas funções usadas, como src/perfil.c
+__declspec(dllimport) int __stdcall QueryPerformanceCounter(long long *contador);
+__declspec(dllimport) int __stdcall QueryPerformanceFrequency(long long *frequencia);
+
+static inline double TempoSegundos(void)
+{
+    long long freq, agora;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&agora);
+    return (double)agora / (double)freq;
+}
+#else
+#include <time.h>
+static inline double TempoSegundos(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+#endif
+
+// Congruencial linear com semente fixa: mesmas posições em toda execução
+#define BENCH_SEMENTE 12345u
+static unsigned int gSemente = BENCH_SEMENTE;
+
+static inline void SemearAleatorio01(unsigned int semente)
+{
+    gSemente = semente;
+}
+
+// Float uniforme em [0, 1)
+static inline float Aleatorio01(void)
+{
+    gSemente = gSemente * 1664525u + 1013904223u;
+    return (float)(gSemente >> 8) / 16777216.0f;
+}
+
+static inline int CompararDouble(const void *a, const void *b)
+{
+    double da = *(const double *)a;
+    double db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+#endif
@@ -0,0 +1,154 @@
+// Benchmark: custo das consultas de monstros por varredura linear x as
+// consultas exatas da grade espacial que o jogo usa (kernels de
+// testes_acerto.h). `make bench AVX2=1` mede a versão de 8 pontos.
+// Uso: make bench && ./bin/bench_grade_espacial
+#include "grade_espacial.h"
+#include "testes_acerto.h"
+#include "bench_comum.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TILE 64.0f
+#define TILES_MAPA 65
+#define TILES_POR_CELULA 2
+#define RAIO_MONSTRO 18.0f
+#define CONSULTAS 2000
+
+typedef enum { FORMA_CIRCULO = 0, FORMA_CONE, FORMA_SEGMENTO, FORMA_TOTAL } Forma;
+static const char *NOMES_FORMA[FORMA_TOTAL] = { "circulo", "cone", "segmento" };
+
+typedef struct {
+    Vector2 origem;
+    Vector2 direcao;
+    Vector2 fim;
+} Consulta;
+
+static bool DentroCirculo(Vector2 p, Vector2 c, float raio)
+{
+    float dx = p.x - c.x, dy = p.y - c.y;
+    return dx * dx + dy * dy <= raio * raio;
+}
+
+static bool DentroCone(Vector2 p, const Consulta *q, float alcance, float aberturaGraus)
+{
+    float dx = p.x - q->origem.x, dy = p.y - q->origem.y;
+    float dist = sqrtf(dx * dx + dy * dy);
+    if (dist <= 0.0001f) return true;
+    if (dist - RAIO_MONSTRO > alcance) return false;
+    float dot = (dx * q->direcao.x + dy * q->direcao.y) / dist;
+    if (dot > 1.0f) dot = 1.0f;
+    if (dot < -1.0f) dot = -1.0f;
+    float angulo = acosf(dot) * RAD2DEG;
+    float meia = aberturaGraus * 0.5f + asinf(fminf(RAIO_MONSTRO / dist, 1.0f)) * RAD2DEG;
+    return angulo <= meia;
+}
+
+static bool DentroSegmento(Vector2 p, Vector2 a, Vector2 b, float raio)
+{
+    float sx = b.x - a.x, sy = b.y - a.y;
+    float c2 = sx * sx + sy * sy;
+    float t = c2 > 0.0001f ? ((p.x - a.x) * sx + (p.y - a.y) * sy) / c2 : 0.0f;
+    if (t < 0.0f) t = 0.0f;
+    if (t > 1.0f) t = 1.0f;
+    float dx = p.x - (a.x + sx * t), dy = p.y - (a.y + sy * t);
+    return sqrtf(dx * dx + dy * dy) <= raio;
+}
+
+static bool Testar(Forma forma, Vector2 p, const Consulta *q)
+{
+    switch (forma) {
+        case FORMA_CIRCULO: return DentroCirculo(p, q->origem, 220.0f);
+        case FORMA_CONE: return DentroCone(p, q, 150.0f, 80.0f);
+        case FORMA_SEGMENTO: return DentroSegmento(p, q->origem, q->fim, 12.0f + RAIO_MONSTRO);
+        default: return false;
+    }
+}
+
+static int Exata(Forma forma, const GradeEspacial *g, const Consulta *q, int *saida, int cap)
+{
+    switch (forma) {
+        case FORMA_CIRCULO:
+            return GradeEspacial_ConsultarCirculo(g, q->origem, 220.0f, saida, cap);
+        case FORMA_CONE:
+            return GradeEspacial_ConsultarCone(g, q->origem, q->direcao, 150.0f, 80.0f, RAIO_MONSTRO, saida, cap);
+        case FORMA_SEGMENTO:
+            return GradeEspacial_ConsultarCapsula(g, q->origem, q->fim, 12.0f + RAIO_MONSTRO, saida, cap);
+        default:
+            return 0;
+    }
+}
+
+static void ExecutarCenario(int quantidade)
+{
+    const float mundo = TILES_MAPA * TILE;
+    Vector2 *posicoes = (Vector2 *)malloc((size_t)quantidade * sizeof(Vector2));
+    int *saida = (int *)malloc((size_t)quantidade * sizeof(int));
+    Consulta *consultas = (Consulta *)malloc(CONSULTAS * sizeof(Consulta));
+    if (!posicoes || !saida || !consultas) {
+        printf("Sem memoria para %d monstros\n", quantidade);
+        free(posicoes); free(saida); free(consultas);
+        return;
+    }
+
+    for (int i = 0; i < quantidade; ++i) {
+        posicoes[i] = (Vector2){ TILE + Aleatorio01() * (mundo - 2 * TILE), TILE + Aleatorio01() * (mundo - 2 * TILE) };
+    }
+    for (int i = 0; i < CONSULTAS; ++i) {
+        float angulo = Aleatorio01() * 2.0f * PI;
+        Consulta *q = &consultas[i];
+        q->origem = (Vector2){ TILE + Aleatorio01() * (mundo - 2 * TILE), TILE + Aleatorio01() * (mundo - 2 * TILE) };
+        q->direcao = (Vector2){ cosf(angulo), sinf(angulo) };
+        q->fim = (Vector2){ q->origem.x + q->direcao.x * 400.0f, q->origem.y + q->direcao.y * 400.0f };
+    }
+
+    GradeEspacial grade = {0};
+    GradeEspacial_Configurar(&grade, 0.0f, 0.0f, mundo, mundo, TILES_POR_CELULA * TILE);
+
+    const int repeticoesReconstrucao = 200;
+    double t0 = TempoSegundos();
+    for (int r = 0; r < repeticoesReconstrucao; ++r) {
+        GradeEspacial_Limpar(&grade);
+        for (int i = 0; i < quantidade; ++i) GradeEspacial_Inserir(&grade, i, posicoes[i]);
+        GradeEspacial_Finalizar(&grade);
+    }
+    double nsReconstrucao = (TempoSegundos() - t0) * 1e9 / repeticoesReconstrucao;
+    printf("%6d monstros | reconstrucao da grade: %10.0f ns\n", quantidade, nsReconstrucao);
+
+    for (int f = 0; f < FORMA_TOTAL; ++f) {
+        long acertosLinear = 0, acertosGrade = 0;
+
+        t0 = TempoSegundos();
+        for (int c = 0; c < CONSULTAS; ++c) {
+            for (int i = 0; i < quantidade; ++i) {
+                if (Testar((Forma)f, posicoes[i], &consultas[c])) acertosLinear++;
+            }
+        }
+        double nsLinear = (TempoSegundos() - t0) * 1e9 / CONSULTAS;
+
+        t0 = TempoSegundos();
+        for (int c = 0; c < CONSULTAS; ++c) {
+            acertosGrade += Exata((Forma)f, &grade, &consultas[c], saida, quantidade);
+        }
+        double nsGrade = (TempoSegundos() - t0) * 1e9 / CONSULTAS;
+
+        printf("       %-9s | linear: %10.0f ns/consulta | grade: %8.0f ns/consulta | %6.1fx | acertos %ld/%ld%s\n",
+               NOMES_FORMA[f], nsLinear, nsGrade, nsGrade > 0.0 ? nsLinear / nsGrade : 0.0,
+               acertosGrade, acertosLinear, acertosGrade == acertosLinear ? "" : "  (DIVERGENTE)");
+    }
+
+    GradeEspacial_Liberar(&grade);
+    free(posicoes);
+    free(saida);
+    free(consultas);
+}
+
+int main(void)
+{
+    printf("kernels de acerto: %s\n", TestesAcerto_Implementacao());
+    const int cenarios[] = { 100, 1000, 10000 };
+    for (size_t i = 0; i < sizeof(cenarios) / sizeof(cenarios[0]); ++i) {
+        ExecutarCenario(cenarios[i]);
+    }
+    return 0;
+}
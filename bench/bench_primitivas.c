@@ -0,0 +1,304 @@
+// Benchmark: primitivas quentes do jogo (testes de acerto por forma, spawn,
+// conversão de posição em tile, passo dos monstros, carga do leaderboard)
+// com quantidades configuráveis. Imprime ns/op e operações por segundo; com
+// --json grava os mesmos números, um caso por linha, para comparar commits.
+// Uso: make bench && ./bin/bench_primitivas [--quantidades 1000,10000]
+//      [--threads N] [--json saida.json]
+#include "jogo.h"
+#include "monstro.h"
+#include "monstro_dados.h"
+#include "testes_acerto.h"
+#include "jogador.h"
+#include "mapa.h"
+#include "pontuacao.h"
+#include "tarefas.h"
+#include "aleatorio.h"
+#include "bench_comum.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TILE 64
+#define TILES_MAPA 65
+#define RAIO_MONSTRO 18.0f
+#define AMOSTRAS 5
+#define TEMPO_MINIMO_AMOSTRA 0.02
+#define MAX_QUANTIDADES 8
+#define MAX_RESULTADOS 64
+#define ARQUIVO_PLACAR "bench_pontuacoes.tmp"
+
+typedef struct {
+    int quantidade;
+    float *x;
+    float *y;
+    uint8_t *mascara;
+    EstadoJogo jogo;            // monstros, grade e campo de fluxo como na partida
+    Mapa *mapa;
+    Jogador jogador;
+    GeradorAleatorio aleatorio;
+    LeaderboardDados placar;
+    double acumulador;          // resultados somados para o compilador não descartar as chamadas
+} Cenario;
+
+// Uma repetição do caso; retorna quantas operações fez
+typedef long (*FuncaoCaso)(Cenario *cenario);
+
+typedef struct {
+    const char *nome;
+    FuncaoCaso executar;
+    FuncaoCaso preparar;        // roda antes de cada amostra (opcional)
+} Caso;
+
+typedef struct {
+    const char *nome;
+    int quantidade;
+    double nsPorOp;
+    double opsPorSegundo;
+} Resultado;
+
+static const float MUNDO = TILES_MAPA * TILE;
+
+static long CasoAcertoCirculo(Cenario *c)
+{
+    Vector2 centro = { MUNDO * 0.5f, MUNDO * 0.5f };
+    c->acumulador += TestesAcerto_Circulo(c->x, c->y, c->quantidade, centro, 220.0f + RAIO_MONSTRO, c->mascara);
+    return c->quantidade;
+}
+
+static long CasoAcertoCone(Cenario *c)
+{
+    ConeAcerto cone = TestesAcerto_PrepararCone((Vector2){ MUNDO * 0.5f, MUNDO * 0.5f }, (Vector2){ 0.6f, 0.8f },
+                                                150.0f, 55.0f, RAIO_MONSTRO);
+    c->acumulador += TestesAcerto_Cone(c->x, c->y, c->quantidade, &cone, c->mascara);
+    return c->quantidade;
+}
+
+static long CasoAcertoCapsula(Cenario *c)
+{
+    CapsulaAcerto capsula = TestesAcerto_PrepararCapsula((Vector2){ MUNDO * 0.25f, MUNDO * 0.5f },
+                                                         (Vector2){ MUNDO * 0.75f, MUNDO * 0.6f },
+                                                         9.0f + RAIO_MONSTRO);
+    c->acumulador += TestesAcerto_Capsula(c->x, c->y, c->quantidade, &capsula, c->mascara);
+    return c->quantidade;
+}
+
+static long CasoGerarMonstros(Cenario *c)
+{
+    for (int i = 0; i < c->quantidade; ++i) {
+        Vector2 spawn = GerarMonstros(&c->jogador, TILES_MAPA, TILES_MAPA, TILE, TILE, &c->aleatorio);
+        c->acumulador += spawn.x;
+    }
+    return c->quantidade;
+}
+
+static long CasoConverterPosicao(Cenario *c)
+{
+    for (int i = 0; i < c->quantidade; ++i) {
+        int linha = 0, coluna = 0;
+        if (ConverterPosicaoParaIndice(c->x[i], c->y[i], TILE, TILE, TILES_MAPA, TILES_MAPA, &linha, &coluna)) {
+            c->acumulador += linha + coluna;
+        }
+    }
+    return c->quantidade;
+}
+
+static long PrepararMonstros(Cenario *c)
+{
+    EstadoJogo *jogo = &c->jogo;
+    ConjuntoMonstros_Limpar(&jogo->monstros);
+    memset(jogo->objetosEmVoo, 0, sizeof(jogo->objetosEmVoo));
+    jogo->gradeMonstrosDesatualizada = true;
+    c->jogador.vida = c->jogador.vidaMaxima;
+    for (int i = 0; i < c->quantidade && i < jogo->limiteMonstros; ++i) {
+        float angulo = Aleatorio_Float01(&c->aleatorio) * 2.0f * PI;
+        float distancia = 200.0f + Aleatorio_Float01(&c->aleatorio) * 1200.0f;
+        Vector2 pos = { c->jogador.posicao.x + cosf(angulo) * distancia,
+                        c->jogador.posicao.y + sinf(angulo) * distancia };
+        AdicionarMonstro(&jogo->monstros, pos, &gMonstrosInfo[i % MONSTRO_TIPOS_COUNT]);
+    }
+    return 0;
+}
+
+// O mesmo passo que JogoAtualizar roda a cada tick
+static long CasoPassoMonstros(Cenario *c)
+{
+    JogoPassoMonstros(&c->jogo, &c->jogador, c->mapa, 1.0f / 60.0f);
+    c->acumulador += c->jogo.monstros.posX[0];
+    return c->jogo.monstros.quantidade;
+}
+
+static long PrepararPlacar(Cenario *c)
+{
+    FILE *arquivo = fopen(ARQUIVO_PLACAR, "w");
+    if (!arquivo) return 0;
+    int entradas = c->quantidade < MAX_ENTRADAS_LEADERBOARD ? c->quantidade : MAX_ENTRADAS_LEADERBOARD;
+    for (int i = 0; i < entradas; ++i) {
+        fprintf(arquivo, "Jogador %d;%d\n", i, (int)(Aleatorio_Float01(&c->aleatorio) * 100000.0f));
+    }
+    fclose(arquivo);
+    return 0;
+}
+
+static long CasoCarregarPlacar(Cenario *c)
+{
+    if (!PontuacaoCarregarArquivo(&c->placar, ARQUIVO_PLACAR)) return 0;
+    c->acumulador += c->placar.entradas[0].pontuacao;
+    return (long)c->placar.quantidade;
+}
+
+static const Caso CASOS[] = {
+    { "acerto_circulo",     CasoAcertoCirculo,    NULL },
+    { "acerto_cone",        CasoAcertoCone,       NULL },
+    { "acerto_capsula",     CasoAcertoCapsula,    NULL },
+    { "gerar_monstros",     CasoGerarMonstros,    NULL },
+    { "converter_posicao",  CasoConverterPosicao, NULL },
+    { "passo_monstros",     CasoPassoMonstros,    PrepararMonstros },
+    { "carregar_placar",    CasoCarregarPlacar,   PrepararPlacar },
+};
+
+// Dobra as repetições até uma amostra passar de TEMPO_MINIMO_AMOSTRA e
+// devolve a mediana de AMOSTRAS amostras, em ns por operação
+static double MedirCaso(const Caso *caso, Cenario *c)
+{
+    long repeticoes = 1;
+    for (;;) {
+        if (caso->preparar) caso->preparar(c);
+        double inicio = TempoSegundos();
+        for (long r = 0; r < repeticoes; ++r) caso->executar(c);
+        if (TempoSegundos() - inicio >= TEMPO_MINIMO_AMOSTRA || repeticoes >= (1L << 24)) break;
+        repeticoes *= 2;
+    }
+
+    double nsPorOp[AMOSTRAS];
+    for (int a = 0; a < AMOSTRAS; ++a) {
+        if (caso->preparar) caso->preparar(c);
+        long operacoes = 0;
+        double inicio = TempoSegundos();
+        for (long r = 0; r < repeticoes; ++r) operacoes += caso->executar(c);
+        double segundos = TempoSegundos() - inicio;
+        nsPorOp[a] = operacoes > 0 ? segundos * 1e9 / (double)operacoes : 0.0;
+    }
+    qsort(nsPorOp, AMOSTRAS, sizeof(double), CompararDouble);
+    return nsPorOp[AMOSTRAS / 2];
+}
+
+static bool PrepararCenario(Cenario *c, int quantidade)
+{
+    memset(c, 0, sizeof(*c));
+    c->quantidade = quantidade;
+    c->x = (float *)malloc((size_t)quantidade * sizeof(float));
+    c->y = (float *)malloc((size_t)quantidade * sizeof(float));
+    c->mascara = (uint8_t *)malloc((size_t)quantidade);
+    c->mapa = criar_mapa(TILES_MAPA, TILES_MAPA, TILE, TILE);
+    if (!c->x || !c->y || !c->mascara || !c->mapa) return false;
+    JogoInicializar(&c->jogo, 0.0f, quantidade);
+    Aleatorio_Semear(&c->aleatorio, BENCH_SEMENTE);
+
+    // Posições espalhadas pela arena, com alguns pontos fora dela
+    for (int i = 0; i < quantidade; ++i) {
+        c->x[i] = -TILE + Aleatorio_Float01(&c->aleatorio) * (MUNDO + 2 * TILE);
+        c->y[i] = -TILE + Aleatorio_Float01(&c->aleatorio) * (MUNDO + 2 * TILE);
+    }
+    c->jogador.posicao = (Vector2){ MUNDO * 0.5f, MUNDO * 0.5f };
+    c->jogador.linhaAtual = TILES_MAPA / 2;
+    c->jogador.colunaAtual = TILES_MAPA / 2;
+    c->jogador.vidaMaxima = 1e9f;
+    c->jogo.posicaoAnteriorJogador = c->jogador.posicao;
+    return true;
+}
+
+static void LiberarCenario(Cenario *c)
+{
+    free(c->x);
+    free(c->y);
+    free(c->mascara);
+    JogoLiberarRecursos(&c->jogo);
+    destruir_mapa(c->mapa);
+}
+
+static bool GravarJson(const char *caminho, const Resultado *resultados, int total)
+{
+    FILE *arquivo = fopen(caminho, "w");
+    if (!arquivo) {
+        printf("Erro: nao foi possivel gravar %s\n", caminho);
+        return false;
+    }
+    fprintf(arquivo, "{\n");
+    fprintf(arquivo, "  \"kernels_acerto\": \"%s\",\n", TestesAcerto_Implementacao());
+    fprintf(arquivo, "  \"threads\": %d,\n", Tarefas_Threads());
+    fprintf(arquivo, "  \"resultados\": [\n");
+    for (int i = 0; i < total; ++i) {
+        fprintf(arquivo, "    {\"caso\": \"%s\", \"quantidade\": %d, \"ns_op\": %.3f, \"ops_s\": %.0f}%s\n",
+                resultados[i].nome, resultados[i].quantidade, resultados[i].nsPorOp,
+                resultados[i].opsPorSegundo, (i + 1 < total) ? "," : "");
+    }
+    fprintf(arquivo, "  ]\n}\n");
+    fclose(arquivo);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    int quantidades[MAX_QUANTIDADES] = { 1000, 10000 };
+    int totalQuantidades = 2;
+    int threads = 1;
+    const char *caminhoJson = NULL;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *valor = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--quantidades") == 0 && valor) {
+            totalQuantidades = 0;
+            for (const char *p = valor; *p && totalQuantidades < MAX_QUANTIDADES;) {
+                int n = atoi(p);
+                if (n > 0) quantidades[totalQuantidades++] = n;
+                p = strchr(p, ',');
+                if (!p) break;
+                ++p;
+            }
+            ++i;
+        } else if (strcmp(argv[i], "--threads") == 0 && valor) {
+            threads = atoi(valor);
+            ++i;
+        } else if (strcmp(argv[i], "--json") == 0 && valor) {
+            caminhoJson = valor;
+            ++i;
+        } else {
+            printf("Aviso: argumento ignorado: %s\n", argv[i]);
+        }
+    }
+    if (totalQuantidades == 0) {
+        printf("Erro: --quantidades sem nenhum valor positivo\n");
+        return 1;
+    }
+
+    Tarefas_Inicializar(threads);
+    printf("kernels de acerto: %s | threads: %d\n", TestesAcerto_Implementacao(), Tarefas_Threads());
+
+    Resultado resultados[MAX_RESULTADOS];
+    int totalResultados = 0;
+    double acumulador = 0.0;
+    for (int q = 0; q < totalQuantidades; ++q) {
+        Cenario cenario;
+        if (!PrepararCenario(&cenario, quantidades[q])) {
+            printf("Sem memoria para %d entidades\n", quantidades[q]);
+            LiberarCenario(&cenario);
+            continue;
+        }
+        for (size_t k = 0; k < sizeof(CASOS) / sizeof(CASOS[0]); ++k) {
+            double ns = MedirCaso(&CASOS[k], &cenario);
+            Resultado r = { CASOS[k].nome, quantidades[q], ns, ns > 0.0 ? 1e9 / ns : 0.0 };
+            printf("%-18s | %7d | %10.3f ns/op | %14.0f op/s\n", r.nome, r.quantidade, r.nsPorOp, r.opsPorSegundo);
+            if (totalResultados < MAX_RESULTADOS) resultados[totalResultados++] = r;
+        }
+        acumulador += cenario.acumulador;
+        LiberarCenario(&cenario);
+    }
+    remove(ARQUIVO_PLACAR);
+    Tarefas_Finalizar();
+
+    // Impede que as chamadas medidas sejam eliminadas como código morto
+    if (acumulador == 1234.5) printf("%f\n", acumulador);
+    if (caminhoJson && !GravarJson(caminhoJson, resultados, totalResultados)) return 1;
+    return 0;
+}
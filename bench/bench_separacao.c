@@ -0,0 +1,100 @@
+// Benchmark: passo de IA dos monstros (reconstrução da grade + perseguição +
+// separação) com hordas de 1k a 5k monstros em volta de um jogador parado,
+// com e sem separação. Mostra o custo por passo contra o orçamento de um
+// quadro a 60 FPS e quantos pares terminam sobrepostos.
+// Uso: make bench && ./bin/bench_separacao
+#include "monstro.h"
+#include "monstro_dados.h"
+#include "grade_espacial.h"
+#include "bench_comum.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TILE 64.0f
+#define TILES_MUNDO 256
+#define TILES_POR_CELULA 2
+#define PASSOS 600
+#define DT (1.0f / 60.0f)
+#define ORCAMENTO_QUADRO_MS (1000.0 / 60.0)
+
+static void ReconstruirGrade(GradeEspacial *grade, const ConjuntoMonstros *c)
+{
+    GradeEspacial_Limpar(grade);
+    for (int i = 0; i < c->quantidade; ++i) {
+        GradeEspacial_Inserir(grade, i, (Vector2){ c->posX[i], c->posY[i] });
+    }
+    GradeEspacial_Finalizar(grade);
+}
+
+// Pares a menos de `distancia` um do outro, contados pela grade
+static long ContarSobrepostos(const GradeEspacial *grade, const ConjuntoMonstros *c, float distancia, int *saida)
+{
+    long pares = 0;
+    for (int i = 0; i < c->quantidade; ++i) {
+        int n = GradeEspacial_ConsultarCirculo(grade, (Vector2){ c->posX[i], c->posY[i] }, distancia,
+                                               saida, c->quantidade);
+        for (int k = 0; k < n; ++k) {
+            if (saida[k] > i) pares++;
+        }
+    }
+    return pares;
+}
+
+static void ExecutarCenario(int quantidade, float raioSeparacao)
+{
+    const float mundo = TILES_MUNDO * TILE;
+    const Vector2 jogador = { mundo * 0.5f, mundo * 0.5f };
+
+    ConjuntoMonstros monstros = {0};
+    GradeEspacial grade = {0};
+    double *tempos = (double *)malloc(PASSOS * sizeof(double));
+    int *saida = (int *)malloc((size_t)quantidade * sizeof(int));
+    if (!tempos || !saida || !ConjuntoMonstros_Inicializar(&monstros, quantidade)) {
+        printf("Sem memoria para %d monstros\n", quantidade);
+        free(tempos);
+        free(saida);
+        return;
+    }
+    GradeEspacial_Configurar(&grade, 0.0f, 0.0f, mundo, mundo, TILES_POR_CELULA * TILE);
+
+    SemearAleatorio01(BENCH_SEMENTE);
+    for (int i = 0; i < quantidade; ++i) {
+        float angulo = Aleatorio01() * 2.0f * PI;
+        float distancia = 200.0f + Aleatorio01() * 1200.0f;
+        Vector2 pos = { jogador.x + cosf(angulo) * distancia, jogador.y + sinf(angulo) * distancia };
+        AdicionarMonstro(&monstros, pos, &gMonstrosInfo[MONSTRO_ZOMBIE]);
+    }
+
+    for (int p = 0; p < PASSOS; ++p) {
+        double inicio = TempoSegundos();
+        ReconstruirGrade(&grade, &monstros);
+        IAAtualizarMonstros(&monstros, jogador, NULL, &grade, raioSeparacao, DT);
+        tempos[p] = (TempoSegundos() - inicio) * 1000.0;
+    }
+
+    double soma = 0.0;
+    for (int p = 0; p < PASSOS; ++p) soma += tempos[p];
+    qsort(tempos, PASSOS, sizeof(double), CompararDouble);
+    double p99 = tempos[(int)((PASSOS - 1) * 0.99)];
+
+    ReconstruirGrade(&grade, &monstros);
+    long sobrepostos = ContarSobrepostos(&grade, &monstros, RAIO_SEPARACAO_PADRAO * 0.5f, saida);
+    printf("%6d monstros | raio %5.1f | %7.3f ms/passo (p99 %7.3f) | %5.1f%% do quadro a 60 FPS | pares sobrepostos %ld\n",
+           quantidade, raioSeparacao, soma / PASSOS, p99, p99 * 100.0 / ORCAMENTO_QUADRO_MS, sobrepostos);
+
+    GradeEspacial_Liberar(&grade);
+    ConjuntoMonstros_Liberar(&monstros);
+    free(tempos);
+    free(saida);
+}
+
+int main(void)
+{
+    const int cenarios[] = { 1000, 2000, 5000 };
+    for (size_t i = 0; i < sizeof(cenarios) / sizeof(cenarios[0]); ++i) {
+        ExecutarCenario(cenarios[i], 0.0f);
+        ExecutarCenario(cenarios[i], RAIO_SEPARACAO_PADRAO);
+    }
+    return 0;
+}
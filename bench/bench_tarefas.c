@@ -0,0 +1,95 @@
+// Benchmark de estresse do sistema de tarefas: pares de ParaleloPara seguidos,
+// como o passo dos monstros faz a cada tick, com tamanhos e lotes variando a
+// cada iteração. Confere que cada item rodou exatamente uma vez por chamada
+// e mostra o custo médio de uma chamada. Um travamento aparece como o
+// progresso parando de andar.
+// Uso: make bench && ./bin/bench_tarefas [--threads N] [--iteracoes N]
+#include "tarefas.h"
+#include "aleatorio.h"
+#include "bench_comum.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ITENS_MAX 8192
+#define AVISOS_PROGRESSO 10
+
+typedef struct {
+    int contagem[ITENS_MAX];
+    int incremento;             // muda entre as duas chamadas do par
+} EstresseTarefas;
+
+static void SomarLote(void *contexto, int inicio, int fim)
+{
+    EstresseTarefas *e = (EstresseTarefas *)contexto;
+    for (int i = inicio; i < fim; ++i) {
+        __atomic_add_fetch(&e->contagem[i], e->incremento, __ATOMIC_RELAXED);
+    }
+}
+
+// Zera as contagens; retorna quantos itens de [0, total) não somaram `esperado`
+static int ConferirEZerar(EstresseTarefas *e, int total, int esperado)
+{
+    int erros = 0;
+    for (int i = 0; i < ITENS_MAX; ++i) {
+        if (e->contagem[i] != (i < total ? esperado : 0)) ++erros;
+        e->contagem[i] = 0;
+    }
+    return erros;
+}
+
+int main(int argc, char **argv)
+{
+    int threads = 8;
+    long iteracoes = 200000;
+    for (int i = 1; i < argc; ++i) {
+        const char *valor = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--threads") == 0 && valor) {
+            threads = atoi(valor);
+            ++i;
+        } else if (strcmp(argv[i], "--iteracoes") == 0 && valor) {
+            iteracoes = atol(valor);
+            ++i;
+        } else {
+            printf("Aviso: argumento ignorado: %s\n", argv[i]);
+        }
+    }
+    if (iteracoes < 1) iteracoes = 1;
+
+    static EstresseTarefas estresse;
+    GeradorAleatorio aleatorio;
+    Aleatorio_Semear(&aleatorio, BENCH_SEMENTE);
+    Tarefas_Inicializar(threads);
+    printf("threads: %d | iteracoes: %ld (2 chamadas cada)\n", Tarefas_Threads(), iteracoes);
+
+    long falhas = 0;
+    double inicio = TempoSegundos();
+    for (long it = 0; it < iteracoes; ++it) {
+        // Metade das iterações no formato do passo dos monstros, metade variando
+        int total = (it & 1) ? Aleatorio_Intervalo(&aleatorio, 1, ITENS_MAX) : 4096;
+        int lote = (it & 1) ? Aleatorio_Intervalo(&aleatorio, 1, 512) : 256;
+
+        estresse.incremento = 1;
+        Tarefas_ParaleloPara(total, lote, SomarLote, &estresse);
+        estresse.incremento = 2;
+        Tarefas_ParaleloPara(total, lote, SomarLote, &estresse);
+        int erros = ConferirEZerar(&estresse, total, 3);
+        if (erros > 0) {
+            if (falhas == 0) {
+                printf("Erro: iteracao %ld (%d itens, lotes de %d): %d itens fora do esperado\n",
+                       it, total, lote, erros);
+            }
+            ++falhas;
+        }
+        if ((it + 1) % (iteracoes / AVISOS_PROGRESSO > 0 ? iteracoes / AVISOS_PROGRESSO : 1) == 0) {
+            printf("  %ld/%ld\n", it + 1, iteracoes);
+            fflush(stdout);
+        }
+    }
+    double segundos = TempoSegundos() - inicio;
+    Tarefas_Finalizar();
+
+    printf("%.3f us por chamada (com a conferencia) | iteracoes com erro: %ld\n",
+           segundos * 1e6 / (double)(iteracoes * 2), falhas);
+    return falhas > 0 ? 1 : 0;
+}
@@ -0,0 +1,26 @@
+#ifndef ALEATORIO_H
+#define ALEATORIO_H
+
+#include <stdint.h>
+
+// Gerador PCG32 (XSH RR). Cada EstadoJogo tem o seu: a mesma semente reproduz
+// a mesma sequência em qualquer máquina, e sementes diferentes caem em fluxos
+// (incrementos) diferentes, então partidas paralelas não compartilham estado.
+typedef struct {
+    uint64_t estado;
+    uint64_t incremento;
+} GeradorAleatorio;
+
+void Aleatorio_Semear(GeradorAleatorio *g, uint64_t semente);
+uint32_t Aleatorio_Proximo(GeradorAleatorio *g);
+
+// Inteiro uniforme em [min, max] (inclusive, sem viés de módulo)
+int Aleatorio_Intervalo(GeradorAleatorio *g, int min, int max);
+
+// Float uniforme em [0, 1)
+float Aleatorio_Float01(GeradorAleatorio *g);
+
+// Semente nova para partidas jogadas na janela (relógio + contador)
+uint64_t Aleatorio_SementeNova(void);
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef ALOCACOES_H
+#define ALOCACOES_H
+
+#include <stdbool.h>
+
+// Vigia de alocações: em builds com -DMTA_ALOCACOES (make ALOCACOES=1) o
+// link troca malloc/calloc/realloc/free e as cargas de textura do raylib
+// (LoadTexture, LoadTextureFromImage, LoadRenderTexture) por ganchos com
+// -Wl,--wrap. Como o raylib é ligado estático, o MemAlloc dele também passa
+// pelos ganchos. Dentro de um escopo vigiado (JogoAtualizar, JogoDesenhar)
+// e passados ALOCACOES_CARENCIA_S segundos de partida, cada chamada vira uma
+// ocorrência, relatada ao fechar o escopo com o endereço de quem chamou (para
+// o addr2line; em binários PIE, descontado o endereço base do executável).
+// Com ALOCACOES=2 a primeira ocorrência aborta o programa.
+// Sem a flag as macros abaixo viram nada e o módulo não gera código.
+//
+// Os ganchos não imprimem nem alocam: só anotam num buffer fixo, de qualquer
+// thread (os lotes do sistema de tarefas contam como parte do escopo).
+// Escopos são abertos e fechados só pela thread principal.
+
+#ifndef ALOCACOES_CARENCIA_S
+#define ALOCACOES_CARENCIA_S 5.0f   // segundos de partida livres para aquecer caches
+#endif
+
+#ifdef MTA_ALOCACOES
+
+void Alocacoes_IniciarEscopo(const char *nome, float tempoPartida);
+void Alocacoes_FinalizarEscopo(void);
+// Total de ocorrências desde o início do programa, impresso ao sair
+void Alocacoes_Relatorio(void);
+
+#define ALOCACOES_INICIO(nome, tempo)   Alocacoes_IniciarEscopo((nome), (tempo))
+#define ALOCACOES_FIM()                 Alocacoes_FinalizarEscopo()
+#define ALOCACOES_RELATORIO()           Alocacoes_Relatorio()
+
+#else
+
+#define ALOCACOES_INICIO(nome, tempo)   ((void)(tempo))
+#define ALOCACOES_FIM()                 ((void)0)
+#define ALOCACOES_RELATORIO()           ((void)0)
+
+#endif
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef APP_H
 #define APP_H
 
-int AplicacaoExecutar(void);
+// Opções: --ticks N (passos de simulação por segundo), --fps N (0 = sem limite), --vsync
+int AplicacaoExecutar(int argc, char **argv);
 
 #endif
@@ -0,0 +1,36 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Alocador linear para dados que vivem uma partida inteira: um bloco do heap
+// pedido uma vez e recortado em pedaços alinhados. Não há free por pedaço;
+// Arena_Resetar devolve tudo de uma vez e os pedidos recomeçam do início.
+#define ARENA_ALINHAMENTO 16
+
+// Bytes que um pedido de `tamanho` ocupa na arena
+#define ARENA_TAMANHO(tamanho) \
+    (((size_t)(tamanho) + ARENA_ALINHAMENTO - 1) & ~(size_t)(ARENA_ALINHAMENTO - 1))
+
+typedef struct Arena {
+    unsigned char *base;
+    size_t capacidade;
+    size_t usado;
+    size_t pico;            // maior `usado` desde Inicializar
+    int reservas;           // pedidos atendidos desde o último Resetar
+    int falhas;             // pedidos que não couberam desde Inicializar
+} Arena;
+
+bool Arena_Inicializar(Arena *arena, size_t capacidade);
+void Arena_Liberar(Arena *arena);
+void Arena_Resetar(Arena *arena);
+
+// Memória não inicializada, alinhada a ARENA_ALINHAMENTO; NULL se não couber
+void *Arena_Alocar(Arena *arena, size_t tamanho);
+
+// Posição atual; Arena_Voltar(marca) devolve tudo que foi pedido depois dela
+size_t Arena_Marca(const Arena *arena);
+void Arena_Voltar(Arena *arena, size_t marca);
+
+#endif
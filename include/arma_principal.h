@@ -2,6 +2,7 @@
 #define ARMA_PRINCIPAL_H
 
 #include "raylib.h"
+#include "texturas.h"
 #include <stdbool.h>
 #include <stddef.h>
 
@@ -35,8 +36,8 @@ typedef struct {
     float tempoRecargaRestante;
     float aberturaConeGraus;
     const char *spriteBase;
-    Texture2D spriteIdleOuFrame1;
-    Texture2D spriteFrame2;
+    IdTextura spriteIdleOuFrame1;
+    IdTextura spriteFrame2;
     Vector2 offsetFrame1;
     Vector2 offsetFrame2;
     float larguraLinha;
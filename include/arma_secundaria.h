@@ -2,6 +2,7 @@
 #define ARMA_SECUNDARIA_H
 
 #include "raylib.h"
+#include "texturas.h"
 #include <stdbool.h>
 #include <stddef.h>
 
@@ -22,8 +23,8 @@ typedef struct {
     float duracao;
     float tempoRecarga;
     const char *spriteBase;
-    Texture2D spriteIdleOuFrame1;
-    Texture2D spriteFrame2;
+    IdTextura spriteIdleOuFrame1;
+    IdTextura spriteFrame2;
     Vector2 offsetFrame1;
     Vector2 offsetFrame2;
 } ArmaSecundaria;
@@ -2,6 +2,7 @@
 #define ARMADURA_H
 
 #include "raylib.h"
+#include "texturas.h"
 #include <stdbool.h>
 #include <stddef.h>
 
@@ -23,9 +24,9 @@ typedef struct {
     const char *descricao;
     const char *spriteBase;
     ModificadorArmadura modificador;
-    Texture2D spriteIdle;
-    Texture2D spriteAndando1;
-    Texture2D spriteAndando2;
+    IdTextura spriteIdle;
+    IdTextura spriteAndando1;
+    IdTextura spriteAndando2;
 } Armadura;
 
 extern Armadura gArmaduras[];
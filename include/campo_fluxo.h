@@ -0,0 +1,54 @@
+#ifndef CAMPO_FLUXO_H
+#define CAMPO_FLUXO_H
+
+#include "raylib.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+struct Mapa;
+struct Arena;
+
+// Campo de fluxo até o tile do jogador: uma BFS sobre os tiles sem colisão,
+// refeita só quando o jogador troca de tile, guarda para cada tile a direção
+// a seguir. Todos os monstros consultam o mesmo campo em O(1), sem custo de
+// caminho por monstro. Tiles cujo retângulo até o alvo está livre têm linha
+// de visão e seguem em linha reta; os outros vão para o vizinho mais perto.
+// Em mapas grandes o campo cobre só uma janela em volta do jogador, e nos
+// mapas de arquivo só a parte dela garantida residente (AreaResidenteMapa).
+#define CAMPO_FLUXO_JANELA 256
+
+typedef struct CampoFluxo {
+    int origemLinha;            // canto da janela no mapa, em tiles
+    int origemColuna;
+    int linhas;
+    int colunas;
+    int tileLargura;
+    int tileAltura;
+    int alvoLinha;              // tile do último cálculo; -1 = campo vazio
+    int alvoColuna;
+
+    uint16_t *distancia;        // passos até o alvo (4-vizinhança)
+    uint8_t *direcao;           // vizinho a seguir, reta ou sem caminho
+    int *fila;
+    int capacidade;
+    bool memoriaFixa;           // buffers numa arena: Atualizar não aloca
+} CampoFluxo;
+
+void CampoFluxo_Liberar(CampoFluxo *campo);
+// Recorta de `arena` espaço para uma janela de até `tiles` tiles; mapas que
+// pedirem mais que isso ficam sem campo (monstros vão reto)
+size_t CampoFluxo_TamanhoArena(int tiles);
+bool CampoFluxo_ReservarArena(CampoFluxo *campo, int tiles, struct Arena *arena);
+// Descarta o campo atual; o próximo Atualizar recalcula mesmo sem troca de tile
+void CampoFluxo_Invalidar(CampoFluxo *campo);
+
+// Refaz a BFS se o alvo mudou de tile ou a janela mudou; retorna true quando recalculou
+bool CampoFluxo_Atualizar(CampoFluxo *campo, const struct Mapa *mapa, int linhaAlvo, int colunaAlvo);
+
+// Retorna true e a direção normalizada quando quem está em `posicao` precisa
+// contornar obstáculos; false quando deve ir reto até o alvo (linha de visão,
+// fora da janela ou sem caminho).
+bool CampoFluxo_Desvio(const CampoFluxo *campo, Vector2 posicao, Vector2 *direcao);
+
+#endif
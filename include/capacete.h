@@ -2,6 +2,7 @@
 #define CAPACETE_H
 
 #include "raylib.h"
+#include "texturas.h"
 #include <stdbool.h>
 #include <stddef.h>
 
@@ -18,7 +19,7 @@ typedef struct {
     const char *descricao;
     const char *spriteBase;
     ModificadorCapacete modificador;
-    Texture2D sprite;
+    IdTextura sprite;
 } Capacete;
 
 extern Capacete gCapacetes[];
@@ -0,0 +1,63 @@
+#ifndef GRADE_ESPACIAL_H
+#define GRADE_ESPACIAL_H
+
+#include "raylib.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+struct Arena;
+
+// Grade uniforme de buckets alinhada ao grid de tiles do mapa. É reconstruída
+// por contagem (Limpar -> Inserir... -> Finalizar) e responde consultas de
+// candidatos por célula; o teste exato fica com quem chama.
+typedef struct GradeEspacial {
+    float origemX;
+    float origemY;
+    float tamanhoCelula;
+    int colunas;
+    int linhas;
+
+    int *inicioCelula;      // colunas * linhas + 1 offsets em `indices`
+    int *indices;           // índices das entidades agrupados por célula
+    float *posX;            // posições na mesma ordem de `indices`
+    float *posY;
+
+    int *celulaPendente;    // dados de inserção antes de Finalizar
+    int *indicePendente;
+    float *xPendente;
+    float *yPendente;
+    int quantidade;
+    int capacidade;
+
+    bool memoriaFixa;       // buffers numa arena: Configurar/Inserir não alocam
+    int capacidadeCelulas;  // offsets cabíveis em `inicioCelula` com memoriaFixa
+} GradeEspacial;
+
+bool GradeEspacial_Configurar(GradeEspacial *g, float origemX, float origemY,
+                              float largura, float altura, float tamanhoCelula);
+void GradeEspacial_Liberar(GradeEspacial *g);
+
+// Recorta de `arena` espaço para até `celulas` células e `capacidade`
+// entidades. Depois disso a grade não cresce: Configurar falha se a grade
+// pedida tiver mais células e Inserir falha além da capacidade.
+size_t GradeEspacial_TamanhoArena(int celulas, int capacidade);
+bool GradeEspacial_ReservarArena(GradeEspacial *g, int celulas, int capacidade, struct Arena *arena);
+
+void GradeEspacial_Limpar(GradeEspacial *g);
+bool GradeEspacial_Inserir(GradeEspacial *g, int indice, Vector2 posicao);
+void GradeEspacial_Finalizar(GradeEspacial *g);
+
+// Consultas: escrevem até `capacidade` índices em `saida` e retornam quantos foram escritos.
+// Já fazem o teste exato (kernels de testes_acerto.h sobre as posições de cada
+// linha de células).
+int GradeEspacial_ConsultarCirculo(const GradeEspacial *g, Vector2 centro, float raio,
+                                   int *saida, int capacidade);
+// Pontos cujo círculo de `raioExtra` encosta no setor
+int GradeEspacial_ConsultarCone(const GradeEspacial *g, Vector2 origem, Vector2 direcao,
+                                float alcance, float aberturaGraus, float raioExtra,
+                                int *saida, int capacidade);
+// Pontos a até `raio` do segmento
+int GradeEspacial_ConsultarCapsula(const GradeEspacial *g, Vector2 inicio, Vector2 fim,
+                                   float raio, int *saida, int capacidade);
+
+#endif
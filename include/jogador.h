@@ -3,6 +3,7 @@
 
 #include "raylib.h"
 #include <stdbool.h>
+#include "texturas.h"
 
 struct Mapa;
 
@@ -14,16 +15,18 @@ typedef struct Jogador {
     float vidaMaxima;
     float regeneracaoBase;
 
-    Texture2D parado;
-    Texture2D andando1;
-    Texture2D andando2;
+    IdTextura parado;
+    IdTextura andando1;
+    IdTextura andando2;
 
     float fpsAndar;
     float acumulador;
     bool alternarFrame;
     bool emMovimento;
 
-    struct Mapa *noAtual;
+    // Tile sob o jogador (-1, -1 fora do mapa)
+    int linhaAtual;
+    int colunaAtual;
 } Jogador;
 
 bool IniciarJogador(Jogador* j,
@@ -35,7 +38,10 @@ bool IniciarJogador(Jogador* j,
                     const char* caminhoAndando1,
                     const char* caminhoAndando2);
 
-void AtualizarJogador(Jogador* j, float dt);
+// Direção de movimento pedida pelas teclas WASD/setas (não normalizada)
+Vector2 LerDirecaoMovimentoTeclado(void);
+
+void AtualizarJogador(Jogador* j, Vector2 direcao, float dt);
 
 void DesenharJogador(const Jogador* j);
 
@@ -43,11 +49,8 @@ void DescarregarJogador(Jogador* j);
 
 Vector2 TamanhoJogador(const Jogador* j);
 
-void AplicarColisaoPosicaoJogador(Jogador* j, Vector2 posAnterior,
-                                  struct Mapa **mapa, int linhas, int colunas,
-                                  int tileLargura, int tileAltura);
+void AplicarColisaoPosicaoJogador(Jogador* j, Vector2 posAnterior, const struct Mapa *mapa);
 
-void AtualizarNoAtualJogador(Jogador* j, struct Mapa **mapa, int linhas, int colunas,
-                             int tileLargura, int tileAltura);
+void AtualizarTileAtualJogador(Jogador* j, const struct Mapa *mapa);
 
 #endif // JOGADOR_H
@@ -13,73 +13,91 @@
 #include "estado_habilidade.h"
 #include "monstro.h"
 #include "objeto.h"
+#include "grade_espacial.h"
+#include "campo_fluxo.h"
+#include "aleatorio.h"
+#include "projeteis.h"
+#include "arena.h"
+#include <stdint.h>
 
 #define MAX_OBJETOS_VOO 50
 
+// Frequência padrão do passo fixo de simulação (ticks por segundo)
+#define TAXA_TICKS_PADRAO 60
+
+// Comandos de um passo de simulação (dt fixo). Vêm do teclado/mouse na janela ou de um
+// roteiro no modo headless; JogoAtualizar não lê dispositivos diretamente.
 typedef struct {
-    bool ativo;
-    const ArmaPrincipal *arma;
-    Vector2 origem;
-    Vector2 posicao;
-    Vector2 destino;
-    Vector2 direcao;
-    Vector2 velocidade;
-    float tempoRestante;
-} ProjetilRaygun;
+    Vector2 direcaoMovimento;   // não normalizada; (0, 0) = parado
+    Vector2 mouseNoMundo;
+    bool cliqueEsq;
+    bool cliqueDir;
+    bool pausar;
+} EntradaJogo;
 
 typedef struct {
-    ProjetilRaygun projetilRaygun;
+    ConjuntoProjeteis projeteis;    // tiros do jogador em voo
     EstadoArmaSecundaria armaSecundaria;
     float cooldownArmaSecundaria;
     float regeneracaoAtual;
     bool pausado;
     bool solicitouRetornoMenu;
     EfeitoVisualArmaPrincipal efeitoArmaPrincipal;
-    Monstro monstros[MAX_MONSTROS];
-    int monstrosAtivos;
+    Vector2 posicaoAnteriorJogador;
+    ConjuntoMonstros monstros;
+    int limiteMonstros;
     float tempoSpawnMonstro;
     float intervaloSpawnMonstro;
     float tempoTotalJogo;
     int pontuacaoTotal;
     bool jogadorMorto;
     ObjetoLancavel objetosEmVoo[MAX_OBJETOS_VOO];
+    GeradorAleatorio aleatorio;     // toda aleatoriedade da partida sai daqui
+    uint64_t semente;
+    GradeEspacial gradeMonstros;
+    bool gradeMonstrosDesatualizada;
+    CampoFluxo campoFluxo;          // caminhos até o tile do jogador
+    float raioSeparacao;            // distância mínima entre monstros (0 = sem separação)
+    Arena memoriaPartida;           // colunas dos monstros, grade e campo
 } EstadoJogo;
 
-void JogoInicializar(EstadoJogo *estado, float regeneracaoBase);
+// `limiteMonstros` <= 0 usa LIMITE_MONSTROS_PADRAO; a arena da partida é
+// dimensionada por ele e não muda até JogoLiberarRecursos
+void JogoInicializar(EstadoJogo *estado, float regeneracaoBase, int limiteMonstros);
 void JogoReiniciar(EstadoJogo *estado,
                    Jogador *jogador,
                    Camera2D *camera,
-                   Vector2 posInicial);
+                   Vector2 posInicial,
+                   uint64_t semente);
 
 void JogoAtualizar(EstadoJogo *estado,
                    Jogador *jogador,
                    Camera2D *camera,
-                   Mapa **mapa,
+                   Mapa *mapa,
                    int linhasMapa,
                    int colunasMapa,
                    int tileLargura,
                    int tileAltura,
                    float dt,
-                   Vector2 mouseNoMundo,
-                   bool mouseClickEsq,
-                   bool mouseClickDir,
-                   bool escapePress,
+                   const EntradaJogo *entrada,
                    const Armadura *armaduraAtual,
                    const Capacete *capaceteAtual,
                    ArmaPrincipal *armaPrincipalAtual,
                    const ArmaSecundaria *armaSecundariaAtual);
 
+// Passo dos monstros de JogoAtualizar: zona de lentidão, campo de fluxo,
+// velocidades e integração em lotes paralelos, depois arremessos e contato
+// em ordem de índice. Exposto para o benchmark medir o mesmo código.
+void JogoPassoMonstros(EstadoJogo *estado, Jogador *jogador, const Mapa *mapa, float dt);
+
 void JogoDesenhar(EstadoJogo *estado,
                   const Jogador *jogador,
                   const Camera2D *camera,
-                  Mapa **mapa,
-                  Texture2D *tiles,
+                  const Mapa *mapa,
+                  const CamadaMapa *camadaMapa,
+                  const IdTextura *tiles,
                   int quantidadeTiles,
                   int idTileForaMapa,
-                  int linhasMapa,
-                  int colunasMapa,
-                  int tileLargura,
-                  int tileAltura,
                   int largura, int altura,
                   Font fonteNormal,
                   Font fonteBold,
@@ -88,7 +106,8 @@ void JogoDesenhar(EstadoJogo *estado,
                   const ArmaPrincipal *armaPrincipalAtual,
                   const ArmaSecundaria *armaSecundariaAtual,
                   Vector2 mousePos,
-                  bool mouseClick);
+                  bool mouseClick,
+                  float alfa);
 
 void JogoLiberarRecursos(EstadoJogo *estado);
 
@@ -2,32 +2,73 @@
 #define MAPA_H
 
 #include "raylib.h"
+#include "texturas.h"
+#include "regioes_mapa.h"
 #include <stdbool.h>
+#include <stdint.h>
 
+// Dimensões da arena em tiles (inclui a cerca da borda)
+#define MAPA_LINHAS 65
+#define MAPA_COLUNAS 65
+
+// Grade contígua de tiles: um byte de id por tile e um bit de colisão, linha
+// a linha. Vizinhos e posição de cada tile saem de aritmética de índice.
+// Mapas grandes vêm de arquivo e ficam só parcialmente na memória: aí
+// `regioes` responde pelos tiles e idsTile/colisao ficam NULL.
 typedef struct Mapa {
-    int id_tile;
-    bool colisao;
-    int linha;
-    int coluna;
-
-    float posX;
-    float posY;
-
-    struct Mapa *cima;
-    struct Mapa *baixo;
-    struct Mapa *esquerda;
-    struct Mapa *direita;
+    int linhas;
+    int colunas;
+    int tileLargura;
+    int tileAltura;
+    uint8_t *idsTile;       // linhas * colunas
+    uint32_t *colisao;      // bitset na mesma ordem de idsTile
+    RegioesMapa *regioes;
 } Mapa;
 
-Mapa **criar_mapa_encadeado(int L, int C, int tile_w, int tile_h);
-void destruir_mapa_encadeado(Mapa **linhas, int L);
+Mapa *criar_mapa(int L, int C, int tile_w, int tile_h);
+void destruir_mapa(Mapa *mapa);
+
+// Grava em arquivo de regiões a mesma arena que criar_mapa gera, em qualquer tamanho
+bool GravarMapaArquivo(const char *caminho, int linhas, int colunas);
+Mapa *AbrirMapaArquivo(const char *caminho, int tileLargura, int tileAltura);
+// Mantém residentes as regiões perto de `posicao` (no mundo); não faz nada
+// em mapas criados inteiros na memória
+void AtualizarRegioesMapa(Mapa *mapa, Vector2 posicao);
+// Retângulo de tiles que AtualizarRegioesMapa garantiu residente; o mapa
+// inteiro nos mapas criados na memória
+void AreaResidenteMapa(const Mapa *mapa, int *linha, int *coluna, int *linhas, int *colunas);
 bool ConverterPosicaoParaIndice(float posX, float posY, int tileLargura, int tileAltura,
                                 int maxLinhas, int maxColunas, int *outI, int *outJ);
-bool TilePossuiColisao(Mapa **mapa, int linhas, int colunas, int i, int j);
-void DesenharMapaVisivel(Camera2D *camera, int telaLargura, int telaAltura,
-                         Mapa **mapa, int linhas, int colunas,
-                         Texture2D *tiles, int quantidadeTiles,
-                         int tileLargura, int tileAltura,
-                         int idTileForaMapa);
+// Fora do mapa conta como colisão
+bool TilePossuiColisao(const Mapa *mapa, int i, int j);
+int IdTileMapa(const Mapa *mapa, int i, int j);
+
+// Desenha tile a tile o que a câmera enxerga; retorna quantos sprites desenhou
+int DesenharMapaVisivel(Camera2D *camera, int telaLargura, int telaAltura,
+                        const Mapa *mapa, const IdTextura *tiles, int quantidadeTiles,
+                        int idTileForaMapa);
+
+// Camada estática do mapa pré-renderizada em blocos de TILES_POR_CHUNK x
+// TILES_POR_CHUNK tiles, montada uma vez depois que o mapa e o atlas existem.
+// Cada quadro desenha só os blocos que a câmera enxerga; tudo fora do mapa
+// usa o mesmo bloco de rua. Mapas em regiões não têm camada: são desenhados
+// tile a tile.
+#define TILES_POR_CHUNK 16
+
+typedef struct {
+    RenderTexture2D *chunks;            // chunksLinhas * chunksColunas, cobrindo o mapa
+    RenderTexture2D chunkForaMapa;
+    int chunksLinhas;
+    int chunksColunas;
+    int tileLargura;
+    int tileAltura;
+    bool pronta;
+} CamadaMapa;
+
+bool CamadaMapa_Construir(CamadaMapa *camada, const Mapa *mapa,
+                          const IdTextura *tiles, int quantidadeTiles, int idTileForaMapa);
+void CamadaMapa_Liberar(CamadaMapa *camada);
+// Retorna quantos blocos desenhou (0 se a camada não estiver pronta)
+int DesenharCamadaMapa(const CamadaMapa *camada, const Camera2D *camera, int telaLargura, int telaAltura);
 
 #endif
@@ -3,10 +3,16 @@
 
 #include "raylib.h"
 #include <stdbool.h>
+#include <stddef.h>
+#include "texturas.h"
+#include "aleatorio.h"
 
 struct ObjetoLancavel;
 struct MonstroInfo;
 struct Jogador;
+struct CampoFluxo;
+struct GradeEspacial;
+struct Arena;
 
 // Enum para tipos de monstros
 typedef enum
@@ -22,58 +28,107 @@ typedef enum
     MONSTRO_TIPOS_COUNT = 8
 } TipoMonstro;
 
-typedef struct Monstro
+// Monstros vivos guardados em colunas (SoA). Os índices [0, quantidade) são
+// densos: remover um monstro move o último para a posição liberada. Dados
+// constantes por tipo (dano, alcance, recargas...) vêm de MonstroInfo.
+typedef struct ConjuntoMonstros
 {
-    Vector2 posicao;
-    float vida;
-    float vidaMaxima;
-    float velocidade;
-    TipoMonstro tipo;
-    bool ativo; // Indica se o monstro está vivo/ativo
-
-    Texture2D sprite1;
-    Texture2D sprite2;
-    Texture2D sprite3;
-
-    float fpsAnimacao;
-    float acumulador;
-    int frameAtual;
-
-    float alcanceAtaque;
-    float cooldownAtaque;
-    float acumuladorAtaque;
-    float danoContato;
-    int pontuacao;
-
-    float cooldownArremesso;
-    float acumuladorArremesso;
-
-    struct ObjetoLancavel *objeto;
-} Monstro;
-
-// Define número máximo de monstros simultâneos
-#define MAX_MONSTROS 100
-
-bool IniciarMonstro(Monstro *m,
-                    Vector2 posInicial,
-                    const struct MonstroInfo *info);
-
-void DescarregarMonstro(Monstro *m);
-
-void CarregarAssetsMonstro(Monstro *m);
-
-bool TentarLancarObjeto(Monstro *m, float dt, Vector2 alvo);
-
-void AtualizarMonstro(Monstro *m, float dt);
-
-void DesenharMonstro(const Monstro *m);
-
-// IA: Move o monstro constantemente em direção ao jogador
-void IAAtualizarMonstro(Monstro *m, struct Jogador *jogador, float dt);
-
-// Colisão: Retorna true se o monstro colidiu com o jogador
-bool VerificarColisaoMonstroJogador(Monstro *m, struct Jogador *jogador);
-
-Vector2 GerarMonstros(struct Jogador *jogador, int mapL, int mapC, int tileW, int tileH);
+    int quantidade;
+    int capacidade;
+
+    float *posX;
+    float *posY;
+    float *posXAnterior;        // posição no passo anterior, para interpolar o desenho
+    float *posYAnterior;
+    float *velX;
+    float *velY;
+    float *vida;
+    float *fatorVelocidade;     // 1.0 normal, < 1.0 dentro de zonas de lentidão
+    unsigned char *tipo;        // TipoMonstro
+
+    float *acumuladorAnimacao;
+    unsigned char *frame;       // 0..2
+    float *acumuladorAtaque;
+    float *acumuladorArremesso;
+    unsigned char *intencao;    // INTENCAO_*, gerada na fase paralela do passo
+
+    bool capacidadeFixa;        // colunas numa arena: não crescem nem são liberadas aqui
+} ConjuntoMonstros;
+
+// Limite padrão de monstros simultâneos (a capacidade das colunas cresce sob demanda)
+#define LIMITE_MONSTROS_PADRAO 100
+// Teto para --monstros: um vetor de índices desse tamanho cabe no rascunho do quadro
+#define LIMITE_MONSTROS_MAXIMO 16384
+// Distância abaixo da qual dois monstros se empurram; 0 desliga a separação
+#define RAIO_SEPARACAO_PADRAO 36.0f
+#define MAX_VIZINHOS_SEPARACAO 32
+
+// O que cada monstro quer fazer com o jogador neste passo. As intenções são
+// geradas em paralelo e aplicadas depois, em ordem de índice, por uma só thread.
+#define INTENCAO_ARREMESSO 0x01     // recarga zerada e jogador no alcance
+#define INTENCAO_CONTATO   0x02     // encostou no jogador com o ataque pronto
+
+bool ConjuntoMonstros_Inicializar(ConjuntoMonstros *c, int capacidadeInicial);
+void ConjuntoMonstros_Liberar(ConjuntoMonstros *c);
+void ConjuntoMonstros_Limpar(ConjuntoMonstros *c);
+
+// Colunas recortadas de `arena` para exatamente `capacidade` monstros;
+// AdicionarMonstro retorna -1 quando enchem, sem recorrer ao heap
+size_t ConjuntoMonstros_TamanhoArena(int capacidade);
+bool ConjuntoMonstros_InicializarArena(ConjuntoMonstros *c, int capacidade, struct Arena *arena);
+
+// Retorna o índice do novo monstro ou -1 se não houver memória
+int AdicionarMonstro(ConjuntoMonstros *c, Vector2 posInicial, const struct MonstroInfo *info);
+void RemoverMonstro(ConjuntoMonstros *c, int indice);
+
+// Pré-carrega no cache os sprites de todos os tipos de monstro e seus objetos
+bool CarregarTexturasMonstros(void);
+void DescarregarTexturasMonstros(void);
+IdTextura ObterSpriteObjetoMonstro(TipoMonstro tipo);
+
+// Copia as posições atuais para posXAnterior/posYAnterior (início de cada passo)
+void ArmazenarPosicoesAnterioresMonstros(ConjuntoMonstros *c);
+
+// Fase paralela do passo: as funções abaixo recebem uma faixa [inicio, fim)
+// de índices e só escrevem nos monstros dela, então faixas disjuntas podem
+// rodar em threads diferentes com o mesmo resultado da execução serial.
+
+// Animação e recargas de ataque/arremesso
+void AtualizarTemporizadoresMonstros(ConjuntoMonstros *c, int inicio, int fim, float dt);
+
+// IA: calcula a velocidade de cada monstro em direção ao alvo. Com `campo` os
+// monstros sem linha de visão contornam obstáculos por ele; com `grade`
+// (montada com as posições atuais) os que estão a menos de `raioSeparacao` de
+// outro se afastam, espalhando a horda. Lê posições de todos os monstros:
+// nenhuma faixa pode integrar antes de todas calcularem.
+void IACalcularVelocidadesMonstros(ConjuntoMonstros *c, int inicio, int fim, Vector2 alvo,
+                                   const struct CampoFluxo *campo, const struct GradeEspacial *grade,
+                                   float raioSeparacao);
+void IAIntegrarMonstros(ConjuntoMonstros *c, int inicio, int fim, float dt);
+
+// Atualiza a recarga de arremesso e preenche `intencao` com as posições já
+// integradas; o contato considera o trajeto do passo (posXAnterior -> posX)
+void GerarIntencoesMonstros(ConjuntoMonstros *c, int inicio, int fim, float dt, const struct Jogador *jogador,
+                            Vector2 posicaoAnteriorJogador);
+
+// Calcula velocidades e integra todos os monstros numa thread só
+void IAAtualizarMonstros(ConjuntoMonstros *c, Vector2 alvo, const struct CampoFluxo *campo,
+                         const struct GradeEspacial *grade, float raioSeparacao, float dt);
+
+// Objeto arremessado por um monstro com INTENCAO_ARREMESSO em direção a `alvo`
+void PrepararObjetoMonstro(const ConjuntoMonstros *c, int indice, Vector2 alvo,
+                           struct ObjetoLancavel *objeto);
+
+// Colisão: Retorna true se o monstro encostou no jogador em algum ponto do passo
+bool VerificarColisaoMonstroJogador(const ConjuntoMonstros *c, int indice, const struct Jogador *jogador,
+                                    Vector2 posicaoAnteriorJogador);
+
+// alfa em [0, 1] interpola entre a posição anterior e a atual
+void DesenharMonstros(const ConjuntoMonstros *c, float alfa);
+// Só os monstros de `indices`, na ordem dada
+void DesenharMonstrosSelecionados(const ConjuntoMonstros *c, const int *indices, int quantidade, float alfa);
+
+Vector2 GerarMonstros(struct Jogador *jogador, int mapL, int mapC, int tileW, int tileH,
+                      GeradorAleatorio *aleatorio);
 
 #endif
@@ -3,28 +3,29 @@
 
 #include "raylib.h"
 #include <stdbool.h>
+#include "monstro.h"
 
 struct Jogador;
 
+// Estado cinemático de um objeto arremessado. O sprite é resolvido pelo tipo do
+// monstro que o lançou, então o struct pode ser copiado livremente.
 typedef struct ObjetoLancavel {
     Vector2 posicao;
+    Vector2 posicaoAnterior;    // posição no passo anterior, para interpolar o desenho
     Vector2 direcao;
     float velocidade;
     float dano;
-    bool ativo; 
-
     float tempoVida;
-
-    char caminhoSprite[128];
-    Texture2D sprite;
+    TipoMonstro tipo;
+    bool ativo; 
 } ObjetoLancavel;
 
-bool IniciarObjeto(ObjetoLancavel* o, const char* caminhoSprite);
-void DescarregarObjeto(ObjetoLancavel* o);
+void IniciarObjeto(ObjetoLancavel* o, TipoMonstro tipo, float dano, float velocidade);
 
 void AtualizarObjeto(ObjetoLancavel* o, float dt);
 void DesenharObjeto(const ObjetoLancavel* o);
-bool VerificarColisaoObjetoJogador(ObjetoLancavel* o, struct Jogador* jogador);
+// Considera o trajeto do objeto e do jogador desde o início do passo
+bool VerificarColisaoObjetoJogador(ObjetoLancavel* o, struct Jogador* jogador, Vector2 posicaoAnteriorJogador);
 
 #define MAX_TEMPO 5.0f
 
@@ -0,0 +1,41 @@
+#ifndef PACOTE_H
+#define PACOTE_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+// Pacote de assets (.pak) gerado offline por `make pacote` (tools/empacotar_assets.c):
+// imagens já decodificadas em RGBA e fontes já rasterizadas, prontas para
+// subir para a GPU sem abrir nem decodificar PNG/TTF. Inteiros em little-endian.
+//   cabeçalho (16 bytes): "MTAP" | versão u16 | reservado u16 | entradas u32 | reservado u32
+//   diretório: uma entrada de 128 bytes por asset
+//     caminho char[96] | tipo u16 | padding u16 | largura u32 | altura u32 |
+//     formato u32 | offset u32 | tamanho u32 | tamanho base u32 | glifos u32
+//   dados: pixels alinhados a 16 bytes; nas fontes os pixels do atlas de glifos
+//   são seguidos de 32 bytes por glifo (valor, offsetX, offsetY, avanço como
+//   i32 e o retângulo no atlas como 4 floats)
+#define PACOTE_VERSAO 1
+#define PACOTE_TAMANHO_CABECALHO 16
+#define PACOTE_TAMANHO_ENTRADA 128
+#define PACOTE_TAMANHO_CAMINHO 96
+#define PACOTE_TAMANHO_GLIFO 32
+#define PACOTE_CAMINHO_PADRAO "assets.pak"
+
+typedef enum {
+    PACOTE_ASSET_IMAGEM = 1,
+    PACOTE_ASSET_FONTE = 2
+} TipoAssetPacote;
+
+// Mapeia o arquivo em memória (no Windows, lê inteiro num único bloco).
+// Sem pacote o jogo continua carregando os arquivos soltos de assets/.
+bool Pacote_Abrir(const char *caminho);
+void Pacote_Fechar(void);
+bool Pacote_Aberto(void);
+
+// A imagem aponta direto para o arquivo mapeado: não chamar UnloadImage nem
+// modificá-la, e não usá-la depois de Pacote_Fechar.
+bool Pacote_ObterImagem(const char *caminho, Image *saida);
+// Sobe o atlas de glifos para a GPU; liberar com UnloadFont como de costume.
+bool Pacote_CarregarFonte(const char *caminho, Font *saida);
+
+#endif
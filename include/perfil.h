@@ -0,0 +1,92 @@
+#ifndef PERFIL_H
+#define PERFIL_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+// Profiler de quadro: temporizadores por escopo acumulados a cada quadro e
+// guardados em um histórico circular, mostrado num overlay (F3).
+// Só existe quando compilado com -DMTA_PERFIL; sem a flag as macros abaixo
+// viram nada e o módulo não gera código. Um escopo não pode ser aberto de
+// novo antes de fechar, mas pode ser aberto várias vezes no mesmo quadro
+// (os tempos somam, como nos vários passos de simulação de um quadro).
+//
+// Opcionalmente cada escopo fechado, cada quadro e eventos pontuais (spawn,
+// carga de textura) também viram eventos de trace, gravados sem trava num de
+// dois buffers alternados e descarregados num arquivo (Chrome trace_event JSON
+// ou CSV, pela extensão) ao fim de cada quadro em que o buffer passa de 3/4, no
+// F4 e ao fechar o trace. O descarregamento troca o buffer ativo e espera os
+// registros em andamento no outro terminarem antes de escrevê-lo.
+
+#define PERFIL_QUADROS_HISTORICO 240
+#define PERFIL_CAPACIDADE_TRACE (1 << 18)    // eventos em cada um dos dois buffers
+
+typedef enum {
+    PERFIL_QUADRO = 0,          // iteração inteira do loop principal
+    PERFIL_SIMULACAO,           // todos os passos de JogoAtualizar do quadro
+    PERFIL_MONSTROS,            // spawn, IA, ataques e lançamentos dos monstros
+    PERFIL_OBJETOS_LANCADOS,    // AtualizarObjetosLancados
+    PERFIL_ARMA_SECUNDARIA,     // AplicarEfeitosArmaSecundaria
+    PERFIL_DESENHO_MAPA,        // DesenharMapaVisivel
+    PERFIL_DESENHO_ENTIDADES,   // jogador, efeitos, objetos e monstros
+    PERFIL_DESENHO_HUD,         // HUD e menu de pausa
+    PERFIL_APRESENTACAO,        // EndDrawing (swap + espera de vsync/limite de fps)
+    PERFIL_TOTAL_ESCOPOS
+} EscopoPerfil;
+
+typedef struct {
+    float ultimo;   // ms no último quadro fechado
+    float minimo;
+    float media;
+    float p99;
+} EstatisticasPerfil;
+
+#ifdef MTA_PERFIL
+
+double Perfil_Agora(void);
+void Perfil_IniciarQuadro(void);
+void Perfil_FinalizarQuadro(void);
+void Perfil_IniciarEscopo(EscopoPerfil escopo);
+void Perfil_FinalizarEscopo(EscopoPerfil escopo);
+EstatisticasPerfil Perfil_Estatisticas(EscopoPerfil escopo);
+void Perfil_AlternarOverlay(void);
+void Perfil_DesenharOverlay(Font fonte, int largura, int altura);
+
+// Trace: `nome` precisa viver até o descarregamento (use literais).
+// Registrar é seguro de várias threads; Descarregar e Finalizar só da thread
+// principal, fora de qualquer escopo aberto (fim de quadro).
+bool Perfil_IniciarTrace(const char *caminho);
+void Perfil_RegistrarEvento(const char *nome, int valor);
+void Perfil_RegistrarIntervalo(const char *nome, double inicio, int valor);
+void Perfil_DescarregarTrace(void);
+void Perfil_FinalizarTrace(void);
+
+#define PERFIL_INICIO_QUADRO()              Perfil_IniciarQuadro()
+#define PERFIL_FIM_QUADRO()                 Perfil_FinalizarQuadro()
+#define PERFIL_INICIO(escopo)               Perfil_IniciarEscopo(escopo)
+#define PERFIL_FIM(escopo)                  Perfil_FinalizarEscopo(escopo)
+#define PERFIL_ALTERNAR_OVERLAY()           Perfil_AlternarOverlay()
+#define PERFIL_DESENHAR_OVERLAY(f, l, a)    Perfil_DesenharOverlay((f), (l), (a))
+#define PERFIL_AGORA()                      Perfil_Agora()
+#define PERFIL_EVENTO(nome, valor)          Perfil_RegistrarEvento((nome), (valor))
+#define PERFIL_INTERVALO(nome, inicio, v)   Perfil_RegistrarIntervalo((nome), (inicio), (v))
+#define PERFIL_DESCARREGAR_TRACE()          Perfil_DescarregarTrace()
+#define PERFIL_FINALIZAR_TRACE()            Perfil_FinalizarTrace()
+
+#else
+
+#define PERFIL_INICIO_QUADRO()              ((void)0)
+#define PERFIL_FIM_QUADRO()                 ((void)0)
+#define PERFIL_INICIO(escopo)               ((void)0)
+#define PERFIL_FIM(escopo)                  ((void)0)
+#define PERFIL_ALTERNAR_OVERLAY()           ((void)0)
+#define PERFIL_DESENHAR_OVERLAY(f, l, a)    ((void)0)
+#define PERFIL_AGORA()                      0.0
+#define PERFIL_EVENTO(nome, valor)          ((void)0)
+#define PERFIL_INTERVALO(nome, inicio, v)   ((void)(inicio))
+#define PERFIL_DESCARREGAR_TRACE()          ((void)0)
+#define PERFIL_FINALIZAR_TRACE()            ((void)0)
+
+#endif
+
+#endif
@@ -4,6 +4,7 @@
 #include "raylib.h"
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 #define MAX_ENTRADAS_LEADERBOARD 512
 
@@ -19,6 +20,7 @@ typedef struct {
 
 typedef struct {
     int pontuacaoFinal;
+    uint64_t semente;           // semente da partida, para reproduzi-la
     char nome[32];
     int tamanho;
 } CadastroPontuacao;
@@ -37,8 +39,10 @@ typedef struct {
 } ResultadoTelaPontuacao;
 
 void PontuacaoInicializar(EstadoPontuacao *estado);
-void PontuacaoPrepararCadastro(EstadoPontuacao *estado, int pontuacao);
+void PontuacaoPrepararCadastro(EstadoPontuacao *estado, int pontuacao, uint64_t semente);
 void PontuacaoRecarregarArquivo(EstadoPontuacao *estado);
+// Lê "nome;pontos" por linha (até MAX_ENTRADAS_LEADERBOARD) e ordena do maior para o menor
+bool PontuacaoCarregarArquivo(LeaderboardDados *dados, const char *caminho);
 ResultadoLeaderboard PontuacaoDesenharLeaderboard(const EstadoPontuacao *estado,
                                                   Font fonteBold,
                                                   Vector2 mousePos, bool mouseClick,
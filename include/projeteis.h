@@ -0,0 +1,50 @@
+#ifndef PROJETEIS_H
+#define PROJETEIS_H
+
+#include "raylib.h"
+#include <stdbool.h>
+#include "arma_principal.h"
+
+// Máximo de projéteis do jogador em voo ao mesmo tempo
+#define MAX_PROJETEIS 256
+
+// Projéteis do jogador guardados em colunas (SoA) de capacidade fixa. Os slots
+// liberados vão para uma pilha, então disparar e remover são O(1) e nenhum tiro
+// aloca memória. Os laços percorrem só [0, limite), o maior slot em uso desde
+// que o conjunto esvaziou pela última vez; slots inativos têm ativo = false.
+// Um conjunto zerado (memset) já é um conjunto vazio válido.
+typedef struct {
+    int quantidade;                 // projéteis ativos
+    int limite;
+    int quantidadeLivres;
+    int livres[MAX_PROJETEIS];      // pilha de slots abaixo de `limite` sem projétil
+
+    bool ativo[MAX_PROJETEIS];
+    float posX[MAX_PROJETEIS];
+    float posY[MAX_PROJETEIS];
+    float posXAnterior[MAX_PROJETEIS];  // posição no passo anterior, para interpolar o desenho
+    float posYAnterior[MAX_PROJETEIS];
+    float velX[MAX_PROJETEIS];
+    float velY[MAX_PROJETEIS];
+    float tempoRestante[MAX_PROJETEIS];
+    const ArmaPrincipal *arma[MAX_PROJETEIS];   // dano, raio e cor do projétil
+} ConjuntoProjeteis;
+
+void Projeteis_Limpar(ConjuntoProjeteis *p);
+
+// Retorna o slot do novo projétil ou -1 se o conjunto estiver cheio
+int Projeteis_Disparar(ConjuntoProjeteis *p, const ArmaPrincipal *arma, Vector2 origem,
+                       Vector2 velocidade, float duracao);
+void Projeteis_Remover(ConjuntoProjeteis *p, int indice);
+
+// Copia as posições atuais para posXAnterior/posYAnterior (início de cada passo)
+void Projeteis_ArmazenarPosicoesAnteriores(ConjuntoProjeteis *p);
+
+// Integra as posições e desconta `dt` do tempo restante; a colisão e a
+// remoção dos que acertaram ou expiraram ficam com quem chama
+void Projeteis_Mover(ConjuntoProjeteis *p, float dt);
+
+// alfa em [0, 1] interpola entre a posição anterior e a atual
+void Projeteis_Desenhar(const ConjuntoProjeteis *p, float alfa);
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef RASCUNHO_H
+#define RASCUNHO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "arena.h"
+
+// Memória de rascunho do quadro: uma arena global para vetores temporários
+// (candidatos das consultas à grade, listas de índices do desenho). O laço da
+// aplicação chama Rascunho_NovoQuadro no topo de cada quadro e tudo volta de
+// uma vez; dentro do quadro quem pede pode devolver antes, em pilha, com
+// Marca/Voltar. Os pedidos ficam lado a lado num bloco só e nenhum passa pelo
+// heap depois de Inicializar. Só a thread principal usa.
+#define RASCUNHO_CAPACIDADE_PADRAO (256 * 1024)
+
+// Sem Inicializar, o primeiro pedido inicializa com a capacidade padrão
+bool Rascunho_Inicializar(size_t capacidade);
+void Rascunho_Finalizar(void);
+void Rascunho_NovoQuadro(void);
+
+size_t Rascunho_Marca(void);
+void Rascunho_Voltar(size_t marca);
+
+// NULL se não couber (contado em `falhas` das estatísticas)
+void *Rascunho_Alocar(size_t tamanho);
+const Arena *Rascunho_Estatisticas(void);
+
+// Vetor de `n` elementos de `tipo`, não inicializado
+#define RASCUNHO_VETOR(tipo, n) \
+    ((tipo *)Rascunho_Alocar(sizeof(tipo) * (size_t)((n) > 0 ? (n) : 0)))
+
+#endif
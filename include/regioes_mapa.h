@@ -0,0 +1,49 @@
+#ifndef REGIOES_MAPA_H
+#define REGIOES_MAPA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Mapa em arquivo (.mtm) lido por regiões de REGIAO_TILES x REGIAO_TILES
+// tiles. Só as regiões perto do jogador ficam na memória: uma thread de fundo
+// lê as que entram no raio de carga e as que passam do raio de descarte
+// voltam a ficar livres. Inteiros em little-endian.
+//   cabeçalho (32 bytes): "MTAM" | versão u16 | tiles por região u16 |
+//                         linhas u32 | colunas u32 | reservado (16 bytes)
+//   regiões em ordem de linha; cada uma tem REGIAO_TILES² ids de tile (u8,
+//   linha a linha) seguidos do bitset de colisão (1 bit por tile, LSB
+//   primeiro). Regiões da borda são completadas com tiles de colisão.
+#define REGIOES_MAPA_VERSAO 1
+#define REGIAO_TILES 64
+#define REGIOES_RAIO_CARGA 1        // em regiões, em volta da região do jogador
+#define REGIOES_RAIO_ANTECIPACAO 2  // pedidas sem esperar, para a próxima carga já achar prontas
+#define REGIOES_RAIO_DESCARTE 3
+
+typedef struct RegioesMapa RegioesMapa;
+
+// Gera o tile (i, j) de um mapa linhas x colunas ao gravar o arquivo
+typedef uint8_t (*GeradorTileMapa)(int i, int j, int linhas, int colunas, bool *colisao);
+
+bool RegioesMapa_Gravar(const char *caminho, int linhas, int colunas, GeradorTileMapa gerador);
+
+// Abre o arquivo e inicia a thread de leitura; nenhuma região fica residente
+// até o primeiro RegioesMapa_Atualizar.
+RegioesMapa *RegioesMapa_Abrir(const char *caminho, int *linhas, int *colunas);
+void RegioesMapa_Fechar(RegioesMapa *regioes);
+
+// Pede as regiões no raio de antecipação do tile (linha, coluna) e descarta as
+// que ficaram longe. Só retorna quando todas as do raio de carga estão
+// residentes, então nada calculado dentro delas (colisão do jogador, campo de
+// fluxo) depende de quando a leitura de fundo terminou.
+void RegioesMapa_Atualizar(RegioesMapa *regioes, int linha, int coluna);
+// Retângulo de tiles das regiões no raio de carga da última atualização;
+// false antes da primeira
+bool RegioesMapa_AreaResidente(const RegioesMapa *regioes, int *linha, int *coluna,
+                               int *linhas, int *colunas);
+
+// Consultas da thread principal. Tiles de regiões não residentes retornam -1
+// e contam como colisão.
+int RegioesMapa_IdTile(const RegioesMapa *regioes, int i, int j);
+bool RegioesMapa_Colisao(const RegioesMapa *regioes, int i, int j);
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "raylib.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "equipamentos.h"
+#include "jogo.h"
+
+// Arquivo de replay (.mtr): cabeçalho de 36 bytes seguido de um registro por
+// passo de simulação. Todos os inteiros/floats são gravados em little-endian.
+//   "MTAR" | versão u16 | ticks/s u16 | semente u64 | equipamentos u8[4] | passos u32
+//   | linhas do mapa u32 | colunas do mapa u32 | limite de monstros u16 | reservado u16
+// Cada passo ocupa 1 byte de flags (cliques, pausa, teclas de direção) mais
+// 8 bytes da posição do mouse no mundo quando ela mudou desde o passo anterior.
+// A versão 1 (cabeçalho de 24 bytes, sem mapa nem limite) ainda é lida.
+#define REPLAY_VERSAO 2
+
+typedef struct {
+    uint64_t semente;
+    uint16_t taxaTicks;
+    uint8_t equipamentos[CAT_TOTAL];    // índices por CategoriaEquipamento
+    uint32_t quantidadePassos;          // 0 = gravação interrompida, ler até o fim
+    // A arena é gerada só a partir das dimensões, então elas bastam para
+    // identificar o mapa; 0 = desconhecido (versão 1)
+    uint32_t linhasMapa;
+    uint32_t colunasMapa;
+    uint16_t limiteMonstros;
+} CabecalhoReplay;
+
+typedef struct {
+    FILE *arquivo;
+    bool gravando;
+    CabecalhoReplay cabecalho;
+    uint32_t passosProcessados;
+    Vector2 ultimoMouse;
+} Replay;
+
+bool Replay_IniciarGravacao(Replay *r, const char *caminho, const CabecalhoReplay *cabecalho);
+// A direção de movimento é gravada como teclas (sinal de cada eixo)
+bool Replay_GravarPasso(Replay *r, const EntradaJogo *entrada);
+
+bool Replay_AbrirReproducao(Replay *r, const char *caminho);
+// Falso (com a mensagem de erro) se a partida aberta não tem o mapa e o limite
+// de monstros da gravação, onde a reprodução divergiria
+bool Replay_ConfereArena(const Replay *r, int linhasMapa, int colunasMapa, int limiteMonstros);
+// Retorna false quando os passos acabaram
+bool Replay_LerPasso(Replay *r, EntradaJogo *entrada);
+
+// Fecha o arquivo; na gravação também escreve a quantidade final de passos
+void Replay_Fechar(Replay *r);
+bool Replay_Aberto(const Replay *r);
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef SIMULACAO_H
+#define SIMULACAO_H
+
+// Modo headless: roda partidas completas de JogoAtualizar sem janela nem GPU,
+// com a entrada gerada por um roteiro, e imprime uma linha CSV por partida.
+//   --partidas N   quantidade de partidas (padrão 100)
+//   --duracao S    tempo máximo simulado por partida, em segundos (padrão 300)
+//   --monstros N   monstros simultâneos no máximo (padrão 100)
+//   --semente N    semente da primeira partida; as seguintes usam N+1, N+2...
+//                  (cada semente é um fluxo independente, então lotes podem ser
+//                  divididos entre processos por faixas de semente)
+//   --threads N    threads do passo dos monstros contando a principal
+//                  (padrão um por núcleo; 1 = tudo numa thread)
+//   --mapa ARQ        joga na arena gravada com --gerar-mapa, lida por regiões
+//   --gravar ARQ      grava a primeira partida do lote em um replay (.mtr)
+//   --reproduzir ARQ  reproduz um replay gravado (janela ou headless) no lugar do roteiro
+//   --trace ARQ       grava os eventos do profiler (.json ou .csv; exige PERFIL=1)
+int SimulacaoExecutar(int argc, char **argv);
+
+#endif
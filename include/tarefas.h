@@ -0,0 +1,25 @@
+#ifndef TAREFAS_H
+#define TAREFAS_H
+
+#include <stdbool.h>
+
+// Sistema de tarefas com roubo de trabalho: um laço paralelo é dividido em
+// lotes e cada thread (a principal inclusive) recebe uma faixa contígua
+// deles. Quem esvazia a própria faixa rouba metade do que sobrou na de outra
+// thread, então um lote lento não segura os demais. Sem threads auxiliares
+// (ou com um lote só) tudo roda na thread que chamou, sem sincronização.
+#define TAREFAS_MAX_THREADS 16
+
+// Processa os itens [inicio, fim); lotes diferentes podem rodar ao mesmo tempo
+typedef void (*FuncaoTarefa)(void *contexto, int inicio, int fim);
+
+// `threads` conta a principal; <= 0 usa um por núcleo (até TAREFAS_MAX_THREADS)
+bool Tarefas_Inicializar(int threads);
+void Tarefas_Finalizar(void);
+int Tarefas_Threads(void);
+
+// Chama `funcao` sobre [0, total) em lotes de `tamanhoLote` itens e só
+// retorna quando todos terminaram. Só a thread principal pode chamar.
+void Tarefas_ParaleloPara(int total, int tamanhoLote, FuncaoTarefa funcao, void *contexto);
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef TESTES_ACERTO_H
+#define TESTES_ACERTO_H
+
+#include "raylib.h"
+#include <stdint.h>
+
+// Testes exatos de acerto sobre posições empacotadas (x[] e y[] contíguos,
+// como as da grade espacial). Cada função testa `n` pontos de uma vez,
+// escreve 1/0 em `mascara` e retorna quantos acertaram. Com SSE2 ou AVX2
+// (compilando com -mavx2) os pontos são testados 4 ou 8 por vez; sem eles,
+// ou com -DMTA_SEM_SIMD, o laço escalar faz as mesmas contas na mesma ordem
+// e chega ao mesmo resultado.
+
+// Cone com os senos e cossenos já calculados: nenhum teste por ponto usa
+// trigonometria. Um ponto com `raioExtra` acerta se o círculo dele encosta no
+// setor: ângulo até o eixo <= meia abertura + asin(min(raioExtra / distância, 1)).
+typedef struct {
+    float origemX, origemY;
+    float eixoX, eixoY;             // direção normalizada
+    float cosMeia, sinMeia;         // da meia abertura
+    float sinMeia2Largo;            // sen² da meia abertura se >= 90°; FLT_MAX abaixo disso
+    float raio, raio2;              // raioExtra
+    float limite2;                  // (alcance + raioExtra)²
+} ConeAcerto;
+
+// Segmento engrossado por `raio` (linhas de tiro, feixes)
+typedef struct {
+    float inicioX, inicioY;
+    float segX, segY;
+    float inversoComprimento2;      // 0 para segmento degenerado: vira círculo no início
+    float raio2;
+} CapsulaAcerto;
+
+ConeAcerto TestesAcerto_PrepararCone(Vector2 origem, Vector2 direcao, float alcance,
+                                     float aberturaGraus, float raioExtra);
+CapsulaAcerto TestesAcerto_PrepararCapsula(Vector2 inicio, Vector2 fim, float raio);
+
+int TestesAcerto_Circulo(const float *x, const float *y, int n, Vector2 centro, float raio,
+                         uint8_t *mascara);
+int TestesAcerto_Cone(const float *x, const float *y, int n, const ConeAcerto *cone, uint8_t *mascara);
+int TestesAcerto_Capsula(const float *x, const float *y, int n, const CapsulaAcerto *capsula,
+                         uint8_t *mascara);
+
+// Teste de varredura de um ponto só: distância² de `ponto` ao segmento
+// [inicio, fim]. Um círculo que andou de `inicio` a `fim` no passo encostou em
+// outro se o resultado for <= (soma dos raios)²; com os dois em movimento,
+// passe o trajeto de um relativo ao outro e `ponto` = (0, 0).
+float TestesAcerto_DistanciaSegmento2(Vector2 inicio, Vector2 fim, Vector2 ponto);
+
+// "AVX2", "SSE2" ou "escalar"
+const char *TestesAcerto_Implementacao(void);
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef TEXTURAS_H
+#define TEXTURAS_H
+
+#include "raylib.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Handle de uma textura residente no cache (TEXTURA_NENHUMA = sem textura)
+typedef int IdTextura;
+
+#define TEXTURA_NENHUMA 0
+#define MAX_TEXTURAS_CACHE 128
+#define ATLAS_TAMANHO_PAGINA 1024
+#define ATLAS_MAX_PAGINAS 4
+
+// Região de uma textura onde o sprite está: com o atlas montado, vários
+// sprites compartilham a mesma textura e o raylib junta os desenhos num lote só.
+typedef struct {
+    Texture2D textura;
+    Rectangle origem;
+} SpriteTextura;
+
+typedef struct {
+    unsigned long acertos;
+    unsigned long falhas;
+    size_t bytesResidentes;
+    int texturasResidentes;
+    int paginasAtlas;
+    int spritesNoAtlas;
+} EstatisticasTexturas;
+
+bool Texturas_Inicializar(void);
+void Texturas_Finalizar(void);
+
+// Devolve o handle da textura do caminho, carregando do disco apenas na primeira vez.
+// Cada chamada bem-sucedida deve ser pareada com Texturas_Liberar.
+// Até Texturas_ConstruirAtlas a imagem fica só na memória (o tamanho já é
+// conhecido, mas não há o que desenhar); depois disso cada carga nova vira
+// uma textura avulsa.
+IdTextura Texturas_Carregar(const char *caminho);
+
+// Empacota todas as imagens carregadas até agora em páginas de atlas e as
+// envia para a GPU. Imagens que não cabem viram texturas avulsas.
+bool Texturas_ConstruirAtlas(void);
+
+// Sem GPU (modo headless) o cache só registra os caminhos: os handles continuam
+// válidos, mas Texturas_ObterSprite devolve um sprite vazio. Deve ser chamado antes
+// do primeiro Texturas_Carregar.
+void Texturas_DefinirSemGPU(bool semGPU);
+void Texturas_Liberar(IdTextura id);
+SpriteTextura Texturas_ObterSprite(IdTextura id);
+Vector2 Texturas_Tamanho(IdTextura id);
+void Texturas_DesenharSprite(SpriteTextura sprite, Vector2 posicao, float escala, Color cor);
+EstatisticasTexturas Texturas_Estatisticas(void);
+
+#endif
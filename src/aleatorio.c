@@ -0,0 +1,64 @@
+#include "aleatorio.h"
+#include <time.h>
+
+static uint64_t SplitMix64(uint64_t *x)
+{
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+void Aleatorio_Semear(GeradorAleatorio *g, uint64_t semente)
+{
+    if (!g) return;
+    uint64_t x = semente;
+    uint64_t estadoInicial = SplitMix64(&x);
+    g->incremento = (SplitMix64(&x) << 1) | 1u;   // precisa ser ímpar
+    g->estado = 0;
+    Aleatorio_Proximo(g);
+    g->estado += estadoInicial;
+    Aleatorio_Proximo(g);
+}
+
+uint32_t Aleatorio_Proximo(GeradorAleatorio *g)
+{
+    uint64_t anterior = g->estado;
+    g->estado = anterior * 6364136223846793005ull + g->incremento;
+    uint32_t xorDeslocado = (uint32_t)(((anterior >> 18) ^ anterior) >> 27);
+    uint32_t rotacao = (uint32_t)(anterior >> 59);
+    return (xorDeslocado >> rotacao) | (xorDeslocado << ((-rotacao) & 31u));
+}
+
+int Aleatorio_Intervalo(GeradorAleatorio *g, int min, int max)
+{
+    if (!g) return min;
+    if (min > max) {
+        int tmp = min;
+        min = max;
+        max = tmp;
+    }
+    uint32_t faixa = (uint32_t)((int64_t)max - (int64_t)min) + 1u;
+    if (faixa == 0) return (int)Aleatorio_Proximo(g);   // faixa cobre todos os 32 bits
+
+    // Rejeita o início do ciclo que tornaria o módulo enviesado
+    uint32_t limite = (uint32_t)(-faixa) % faixa;
+    uint32_t r;
+    do {
+        r = Aleatorio_Proximo(g);
+    } while (r < limite);
+    return (int)((int64_t)min + (int64_t)(r % faixa));
+}
+
+float Aleatorio_Float01(GeradorAleatorio *g)
+{
+    if (!g) return 0.0f;
+    return (float)(Aleatorio_Proximo(g) >> 8) * (1.0f / 16777216.0f);
+}
+
+uint64_t Aleatorio_SementeNova(void)
+{
+    static uint64_t contador = 0;
+    uint64_t x = ((uint64_t)time(NULL) << 20) ^ (uint64_t)clock() ^ (++contador * 0xD1B54A32D192ED03ull);
+    return SplitMix64(&x);
+}
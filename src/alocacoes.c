@@ -0,0 +1,147 @@
+#ifdef MTA_ALOCACOES
+
+#include "alocacoes.h"
+#include "raylib.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Ocorrências guardadas por escopo; as que passarem disso só entram na contagem
+#define ALOCACOES_MAX_REGISTROS 64
+// Linhas de aviso impressas no programa inteiro, para não inundar o terminal
+#define ALOCACOES_MAX_AVISOS 200
+
+typedef enum {
+    ALOCACAO_MALLOC = 0,
+    ALOCACAO_CALLOC,
+    ALOCACAO_REALLOC,
+    ALOCACAO_FREE,
+    ALOCACAO_TEXTURA
+} TipoAlocacao;
+
+static const char *const NOMES_ALOCACAO[] = { "malloc", "calloc", "realloc", "free", "textura" };
+
+typedef struct {
+    TipoAlocacao tipo;
+    size_t bytes;
+    void *chamador;
+} RegistroAlocacao;
+
+typedef struct {
+    const char *escopo;             // escrito só pela thread principal
+    float tempoPartida;
+    int armado;                     // atômico: dentro de um escopo e passada a carência
+    int ocorrencias;                // atômico: no escopo atual
+    RegistroAlocacao registros[ALOCACOES_MAX_REGISTROS];
+    long total;
+    int avisos;
+} VigiaAlocacoes;
+
+static VigiaAlocacoes gVigia = {0};
+
+// Chamado de dentro dos ganchos: não pode imprimir nem alocar
+static void Registrar(TipoAlocacao tipo, size_t bytes, void *chamador)
+{
+    if (!__atomic_load_n(&gVigia.armado, __ATOMIC_ACQUIRE)) return;
+    int n = __atomic_fetch_add(&gVigia.ocorrencias, 1, __ATOMIC_ACQ_REL);
+    if (n < ALOCACOES_MAX_REGISTROS) {
+        gVigia.registros[n] = (RegistroAlocacao){ tipo, bytes, chamador };
+    }
+}
+
+void Alocacoes_IniciarEscopo(const char *nome, float tempoPartida)
+{
+    gVigia.escopo = nome;
+    gVigia.tempoPartida = tempoPartida;
+    __atomic_store_n(&gVigia.ocorrencias, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&gVigia.armado, tempoPartida >= ALOCACOES_CARENCIA_S, __ATOMIC_RELEASE);
+}
+
+void Alocacoes_FinalizarEscopo(void)
+{
+    __atomic_store_n(&gVigia.armado, 0, __ATOMIC_RELEASE);
+    int n = __atomic_load_n(&gVigia.ocorrencias, __ATOMIC_ACQUIRE);
+    if (n == 0) return;
+    gVigia.total += n;
+
+    int guardadas = n < ALOCACOES_MAX_REGISTROS ? n : ALOCACOES_MAX_REGISTROS;
+    for (int k = 0; k < guardadas && gVigia.avisos < ALOCACOES_MAX_AVISOS; ++k, ++gVigia.avisos) {
+        const RegistroAlocacao *r = &gVigia.registros[k];
+        if (r->tipo == ALOCACAO_TEXTURA) {
+            printf("Aviso: textura carregada em %s aos %.1f s de partida (chamada de %p)\n",
+                   gVigia.escopo, gVigia.tempoPartida, r->chamador);
+        } else {
+            printf("Aviso: %s de %zu bytes em %s aos %.1f s de partida (chamada de %p)\n",
+                   NOMES_ALOCACAO[r->tipo], r->bytes, gVigia.escopo, gVigia.tempoPartida, r->chamador);
+        }
+    }
+    if (n > guardadas && gVigia.avisos < ALOCACOES_MAX_AVISOS) {
+        printf("Aviso: mais %d alocacoes em %s neste passo\n", n - guardadas, gVigia.escopo);
+        gVigia.avisos++;
+    }
+#if MTA_ALOCACOES >= 2
+    printf("Erro: alocacao depois de %.0f s de partida (compilado com ALOCACOES=2)\n",
+           (double)ALOCACOES_CARENCIA_S);
+    abort();
+#endif
+}
+
+void Alocacoes_Relatorio(void)
+{
+    printf("Alocacoes vigiadas: %ld em JogoAtualizar/JogoDesenhar depois de %.0f s de partida\n",
+           gVigia.total, (double)ALOCACOES_CARENCIA_S);
+}
+
+// Ganchos do -Wl,--wrap: o linker manda as chamadas a `f` para __wrap_f, e
+// __real_f é a função original
+void *__real_malloc(size_t tamanho);
+void *__real_calloc(size_t quantidade, size_t tamanho);
+void *__real_realloc(void *ponteiro, size_t tamanho);
+void __real_free(void *ponteiro);
+Texture2D __real_LoadTexture(const char *arquivo);
+Texture2D __real_LoadTextureFromImage(Image imagem);
+RenderTexture2D __real_LoadRenderTexture(int largura, int altura);
+
+void *__wrap_malloc(size_t tamanho)
+{
+    Registrar(ALOCACAO_MALLOC, tamanho, __builtin_return_address(0));
+    return __real_malloc(tamanho);
+}
+
+void *__wrap_calloc(size_t quantidade, size_t tamanho)
+{
+    Registrar(ALOCACAO_CALLOC, quantidade * tamanho, __builtin_return_address(0));
+    return __real_calloc(quantidade, tamanho);
+}
+
+void *__wrap_realloc(void *ponteiro, size_t tamanho)
+{
+    Registrar(ALOCACAO_REALLOC, tamanho, __builtin_return_address(0));
+    return __real_realloc(ponteiro, tamanho);
+}
+
+void __wrap_free(void *ponteiro)
+{
+    if (ponteiro) Registrar(ALOCACAO_FREE, 0, __builtin_return_address(0));
+    __real_free(ponteiro);
+}
+
+Texture2D __wrap_LoadTexture(const char *arquivo)
+{
+    Registrar(ALOCACAO_TEXTURA, 0, __builtin_return_address(0));
+    return __real_LoadTexture(arquivo);
+}
+
+Texture2D __wrap_LoadTextureFromImage(Image imagem)
+{
+    Registrar(ALOCACAO_TEXTURA, 0, __builtin_return_address(0));
+    return __real_LoadTextureFromImage(imagem);
+}
+
+RenderTexture2D __wrap_LoadRenderTexture(int largura, int altura)
+{
+    Registrar(ALOCACAO_TEXTURA, 0, __builtin_return_address(0));
+    return __real_LoadRenderTexture(largura, altura);
+}
+
+#endif
@@ -7,15 +7,29 @@
 #include "equipamentos.h"
 #include "ui_utils.h"
 #include "pontuacao.h"
+#include "texturas.h"
+#include "aleatorio.h"
+#include "replay.h"
+#include "perfil.h"
+#include "alocacoes.h"
+#include "pacote.h"
+#include "tarefas.h"
+#include "rascunho.h"
 #include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
-#define MAP_L 65
-#define MAP_C 65
+#define MAP_L MAPA_LINHAS
+#define MAP_C MAPA_COLUNAS
 #define TOTAL_TILES 15
 #define ID_TILE_GRAMA_BASE 12
 #define ID_TILE_RUA (TOTAL_TILES - 1)
+// Limite de passos de simulação por quadro: um quadro muito longo descarta o
+// atraso restante em vez de travar tentando alcançá-lo
+#define MAX_PASSOS_POR_QUADRO 8
+#define QUADROS_BENCH_MAPA 600
+#define QUADROS_AQUECIMENTO_BENCH 30
 
 static const float LARGURA_BASE_UI = 1280.0f;
 static const float ALTURA_BASE_UI = 720.0f;
@@ -47,10 +61,11 @@ typedef enum {
 } TelaAtual;
 
 typedef struct {
-    Texture2D tiles[TOTAL_TILES];
+    IdTextura tiles[TOTAL_TILES];
     int tileW;
     int tileH;
-    Mapa **mapa;
+    Mapa *mapa;
+    CamadaMapa camadaMapa;
     Jogador jogador;
     EstadoMenu estadoMenu;
     EstadoJogo estadoJogo;
@@ -66,40 +81,64 @@ typedef struct {
     float vidaBaseJogador;
     TelaAtual telaAtual;
     bool solicitarEncerramento;
+
+    float passoSimulacao;
+    float acumuladorSimulacao;
+    EntradaJogo entradaPendente;    // cliques vistos em quadros sem nenhum passo
+    int fpsAlvo;
+    bool vsync;
+    bool benchMapa;                 // --bench-mapa: compara tiles x chunks e sai
+    int threads;                    // --threads: 0 = um por núcleo
+    int limiteMonstros;             // --monstros: 0 = LIMITE_MONSTROS_PADRAO
+
+    const char *caminhoGravacao;    // --gravar: cada partida sobrescreve o arquivo
+    const char *caminhoReproducao;  // --reproduzir: abre direto na partida gravada
+    const char *caminhoTrace;       // --trace: eventos do profiler (.json ou .csv)
+    const char *caminhoMapa;        // --mapa: arena lida de arquivo por regiões
+    Replay replay;
 } AppContext;
 
+static Font CarregarFonte(const char *caminho)
+{
+    Font fonte;
+    if (Pacote_CarregarFonte(caminho, &fonte)) return fonte;
+    return LoadFont(caminho);
+}
+
 static bool CarregarTilesEGerarMapa(AppContext *ctx)
 {
-    ctx->tiles[ID_TILE_GRAMA_BASE] = LoadTexture(CAMINHOS_TILES[ID_TILE_GRAMA_BASE]);
-    if (ctx->tiles[ID_TILE_GRAMA_BASE].id == 0) {
+    ctx->tiles[ID_TILE_GRAMA_BASE] = Texturas_Carregar(CAMINHOS_TILES[ID_TILE_GRAMA_BASE]);
+    if (ctx->tiles[ID_TILE_GRAMA_BASE] == TEXTURA_NENHUMA) {
         printf("Erro: Nao foi possivel carregar tile base\n");
         return false;
     }
-    ctx->tileW = ctx->tiles[ID_TILE_GRAMA_BASE].width;
-    ctx->tileH = ctx->tiles[ID_TILE_GRAMA_BASE].height;
+    Vector2 tamanhoTile = Texturas_Tamanho(ctx->tiles[ID_TILE_GRAMA_BASE]);
+    ctx->tileW = (int)tamanhoTile.x;
+    ctx->tileH = (int)tamanhoTile.y;
 
-    ctx->mapa = criar_mapa_encadeado(MAP_L, MAP_C, ctx->tileW, ctx->tileH);
+    ctx->mapa = ctx->caminhoMapa ? AbrirMapaArquivo(ctx->caminhoMapa, ctx->tileW, ctx->tileH)
+                                 : criar_mapa(MAP_L, MAP_C, ctx->tileW, ctx->tileH);
     if (!ctx->mapa) {
-        UnloadTexture(ctx->tiles[ID_TILE_GRAMA_BASE]);
-        ctx->tiles[ID_TILE_GRAMA_BASE] = (Texture2D){0};
+        Texturas_Liberar(ctx->tiles[ID_TILE_GRAMA_BASE]);
+        ctx->tiles[ID_TILE_GRAMA_BASE] = TEXTURA_NENHUMA;
         return false;
     }
 
     bool sucesso = true;
     for (int i = 0; i < TOTAL_TILES; ++i) {
         if (i == ID_TILE_GRAMA_BASE) continue;
-        ctx->tiles[i] = LoadTexture(CAMINHOS_TILES[i]);
-        if (ctx->tiles[i].id == 0) {
+        ctx->tiles[i] = Texturas_Carregar(CAMINHOS_TILES[i]);
+        if (ctx->tiles[i] == TEXTURA_NENHUMA) {
             printf("Erro: Nao foi possivel carregar tile %s\n", CAMINHOS_TILES[i]);
             sucesso = false;
         }
     }
     if (!sucesso) {
         for (int i = 0; i < TOTAL_TILES; ++i) {
-            if (ctx->tiles[i].id != 0) UnloadTexture(ctx->tiles[i]);
-            ctx->tiles[i] = (Texture2D){0};
+            Texturas_Liberar(ctx->tiles[i]);
+            ctx->tiles[i] = TEXTURA_NENHUMA;
         }
-        destruir_mapa_encadeado(ctx->mapa, MAP_L);
+        destruir_mapa(ctx->mapa);
         ctx->mapa = NULL;
     }
     return sucesso;
@@ -108,14 +147,13 @@ static bool CarregarTilesEGerarMapa(AppContext *ctx)
 static void DescarregarTilesEMapa(AppContext *ctx)
 {
     if (!ctx) return;
+    CamadaMapa_Liberar(&ctx->camadaMapa);
     for (int i = 0; i < TOTAL_TILES; ++i) {
-        if (ctx->tiles[i].id != 0) {
-            UnloadTexture(ctx->tiles[i]);
-            ctx->tiles[i] = (Texture2D){0};
-        }
+        Texturas_Liberar(ctx->tiles[i]);
+        ctx->tiles[i] = TEXTURA_NENHUMA;
     }
     if (ctx->mapa) {
-        destruir_mapa_encadeado(ctx->mapa, MAP_L);
+        destruir_mapa(ctx->mapa);
         ctx->mapa = NULL;
     }
 }
@@ -147,40 +185,190 @@ static void AtualizarEscalaUI(int largura, int altura)
     UI_SetEscala(escalaUIAtual);
 }
 
-static bool AppInicializar(AppContext *ctx)
+static void LerArgumentosApp(AppContext *ctx, int argc, char **argv)
+{
+    int ticks = TAXA_TICKS_PADRAO;
+    ctx->fpsAlvo = 60;
+    ctx->vsync = false;
+    for (int i = 1; i < argc; ++i) {
+        const char *valor = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--ticks") == 0 && valor) {
+            ticks = atoi(valor);
+            ++i;
+        } else if (strcmp(argv[i], "--fps") == 0 && valor) {
+            ctx->fpsAlvo = atoi(valor);
+            ++i;
+        } else if (strcmp(argv[i], "--vsync") == 0) {
+            ctx->vsync = true;
+        } else if (strcmp(argv[i], "--bench-mapa") == 0) {
+            ctx->benchMapa = true;
+        } else if (strcmp(argv[i], "--gravar") == 0 && valor) {
+            ctx->caminhoGravacao = valor;
+            ++i;
+        } else if (strcmp(argv[i], "--reproduzir") == 0 && valor) {
+            ctx->caminhoReproducao = valor;
+            ++i;
+        } else if (strcmp(argv[i], "--trace") == 0 && valor) {
+            ctx->caminhoTrace = valor;
+            ++i;
+        } else if (strcmp(argv[i], "--mapa") == 0 && valor) {
+            ctx->caminhoMapa = valor;
+            ++i;
+        } else if (strcmp(argv[i], "--threads") == 0 && valor) {
+            ctx->threads = atoi(valor);
+            ++i;
+        } else if (strcmp(argv[i], "--monstros") == 0 && valor) {
+            ctx->limiteMonstros = atoi(valor);
+            ++i;
+        } else {
+            printf("Aviso: argumento ignorado: %s\n", argv[i]);
+        }
+    }
+    if (ticks < 10 || ticks > 1000) {
+        printf("Aviso: taxa de ticks %d fora de [10, 1000], usando %d\n", ticks, TAXA_TICKS_PADRAO);
+        ticks = TAXA_TICKS_PADRAO;
+    }
+    if (ctx->fpsAlvo < 0) ctx->fpsAlvo = 0;
+    ctx->passoSimulacao = 1.0f / (float)ticks;
+}
+
+static void IniciarPartida(AppContext *ctx,
+                           Capacete *capacete,
+                           Armadura *armadura,
+                           ArmaPrincipal *armaPrincipal,
+                           ArmaSecundaria *armaSecundaria,
+                           uint64_t semente)
+{
+    ctx->capaceteAtual = capacete;
+    ctx->armaduraAtual = armadura;
+    ctx->armaPrincipalAtual = armaPrincipal;
+    ctx->armaSecundariaAtual = armaSecundaria;
+    if (ctx->armaPrincipalAtual) ctx->armaPrincipalAtual->tempoRecargaRestante = 0.0f;
+    ctx->estadoJogo.regeneracaoAtual =
+        AtualizarVidaJogadorComEquipamentos(&ctx->jogador,
+                                            ctx->armaduraAtual,
+                                            ctx->capaceteAtual,
+                                            ctx->vidaBaseJogador,
+                                            ctx->armaPrincipalAtual);
+    ctx->jogador.vida = ctx->jogador.vidaMaxima;
+    JogoReiniciar(&ctx->estadoJogo, &ctx->jogador, &ctx->camera, ctx->posInicial, semente);
+    ctx->acumuladorSimulacao = 0.0f;
+    ctx->entradaPendente = (EntradaJogo){0};
+    ctx->telaAtual = TELA_JOGO;
+
+    if (ctx->caminhoGravacao && !Replay_Aberto(&ctx->replay)) {
+        CabecalhoReplay cabecalho = {
+            .semente = semente,
+            .taxaTicks = (uint16_t)lroundf(1.0f / ctx->passoSimulacao),
+            .linhasMapa = (uint32_t)ctx->mapa->linhas,
+            .colunasMapa = (uint32_t)ctx->mapa->colunas,
+            .limiteMonstros = (uint16_t)ctx->estadoJogo.limiteMonstros
+        };
+        cabecalho.equipamentos[CAT_ARMA_PRINCIPAL] = armaPrincipal ? (uint8_t)(armaPrincipal - gArmasPrincipais) : 0;
+        cabecalho.equipamentos[CAT_ARMA_SECUNDARIA] = armaSecundaria ? (uint8_t)(armaSecundaria - gArmasSecundarias) : 0;
+        cabecalho.equipamentos[CAT_ARMADURA] = armadura ? (uint8_t)(armadura - gArmaduras) : 0;
+        cabecalho.equipamentos[CAT_CAPACETE] = capacete ? (uint8_t)(capacete - gCapacetes) : 0;
+        Replay_IniciarGravacao(&ctx->replay, ctx->caminhoGravacao, &cabecalho);
+    }
+}
+
+static bool IniciarReproducao(AppContext *ctx)
+{
+    if (!Replay_AbrirReproducao(&ctx->replay, ctx->caminhoReproducao)) return false;
+    const CabecalhoReplay *cabecalho = &ctx->replay.cabecalho;
+    const uint8_t *indices = cabecalho->equipamentos;
+    if (indices[CAT_ARMA_PRINCIPAL] >= gQuantidadeArmasPrincipais ||
+        indices[CAT_ARMA_SECUNDARIA] >= gQuantidadeArmasSecundarias ||
+        indices[CAT_ARMADURA] >= gQuantidadeArmaduras ||
+        indices[CAT_CAPACETE] >= gQuantidadeCapacetes) {
+        printf("Erro: replay usa equipamentos inexistentes\n");
+        Replay_Fechar(&ctx->replay);
+        return false;
+    }
+    if (!Replay_ConfereArena(&ctx->replay, ctx->mapa->linhas, ctx->mapa->colunas,
+                             ctx->estadoJogo.limiteMonstros)) {
+        Replay_Fechar(&ctx->replay);
+        return false;
+    }
+    ctx->passoSimulacao = 1.0f / (float)cabecalho->taxaTicks;
+    IniciarPartida(ctx,
+                   &gCapacetes[indices[CAT_CAPACETE]],
+                   &gArmaduras[indices[CAT_ARMADURA]],
+                   &gArmasPrincipais[indices[CAT_ARMA_PRINCIPAL]],
+                   &gArmasSecundarias[indices[CAT_ARMA_SECUNDARIA]],
+                   cabecalho->semente);
+    return true;
+}
+
+static bool AppInicializar(AppContext *ctx, int argc, char **argv)
 {
     if (!ctx) return false;
     memset(ctx, 0, sizeof(*ctx));
+    LerArgumentosApp(ctx, argc, argv);
+#ifdef MTA_PERFIL
+    if (ctx->caminhoTrace) Perfil_IniciarTrace(ctx->caminhoTrace);
+#else
+    if (ctx->caminhoTrace) printf("Aviso: --trace exige compilar com PERFIL=1\n");
+#endif
+    Tarefas_Inicializar(ctx->threads);
+    if (!Rascunho_Inicializar(RASCUNHO_CAPACIDADE_PADRAO)) return false;
 
     const int larguraInicial = 1280;
     const int alturaInicial = 720;
 
-    SetConfigFlags(FLAG_WINDOW_RESIZABLE);
+    SetConfigFlags(FLAG_WINDOW_RESIZABLE | (ctx->vsync ? FLAG_VSYNC_HINT : 0));
     InitWindow(larguraInicial, alturaInicial, "Magic Toys Arena");
     SetWindowMinSize(960, 540);
-    SetTargetFPS(60);
+    SetTargetFPS(ctx->fpsAlvo);
     SetExitKey(KEY_NULL);
-    Image icone = LoadImage("assets/personagem/personagemParado.png");
-    if (icone.data) {
+    // Opcional: sem o pacote tudo é lido dos arquivos soltos em assets/
+    if (Pacote_Abrir(PACOTE_CAMINHO_PADRAO)) {
+        printf("Assets carregados de %s\n", PACOTE_CAMINHO_PADRAO);
+    }
+
+    const char *caminhoIcone = "assets/personagem/personagemParado.png";
+    Image icone;
+    if (Pacote_ObterImagem(caminhoIcone, &icone)) {
         SetWindowIcon(icone);
-        UnloadImage(icone);
+    } else {
+        icone = LoadImage(caminhoIcone);
+        if (icone.data) {
+            SetWindowIcon(icone);
+            UnloadImage(icone);
+        }
+    }
+
+    Texturas_Inicializar();
+    if (!CarregarTexturasMonstros()) {
+        printf("Aviso: nem todos os sprites de monstros foram carregados\n");
     }
 
-    ctx->fonteNormal = LoadFont("assets/fontes/PixelOperator.ttf");
-    ctx->fonteBold = LoadFont("assets/fontes/PixelOperator-Bold.ttf");
+    ctx->fonteNormal = CarregarFonte("assets/fontes/PixelOperator.ttf");
+    ctx->fonteBold = CarregarFonte("assets/fontes/PixelOperator-Bold.ttf");
 
     if (!CarregarTilesEGerarMapa(ctx)) return false;
 
     ctx->posInicial = (Vector2){
-        (MAP_C * ctx->tileW) / 2.0f,
-        (MAP_L * ctx->tileH) / 2.0f
+        (ctx->mapa->colunas * ctx->tileW) / 2.0f,
+        (ctx->mapa->linhas * ctx->tileH) / 2.0f
     };
 
     if (!IniciarJogadorPadrao(ctx)) return false;
     CarregarTexturasEquipamentos();
+    // Todos os sprites do jogo já estão na memória: junta tudo no atlas
+    if (!Texturas_ConstruirAtlas()) {
+        printf("Aviso: atlas de texturas incompleto\n");
+    }
+    // Daqui em diante nada mais aponta para o pacote mapeado
+    Pacote_Fechar();
+
+    if (!CamadaMapa_Construir(&ctx->camadaMapa, ctx->mapa,
+                              ctx->tiles, TOTAL_TILES, ID_TILE_RUA)) {
+        printf("Aviso: camada do mapa nao pre-renderizada, desenhando tile a tile\n");
+    }
 
     MenuInicializarEstado(&ctx->estadoMenu);
-    JogoInicializar(&ctx->estadoJogo, ctx->jogador.regeneracaoBase);
+    JogoInicializar(&ctx->estadoJogo, ctx->jogador.regeneracaoBase, ctx->limiteMonstros);
     PontuacaoInicializar(&ctx->estadoPontuacao);
 
     ctx->armaduraAtual = NULL;
@@ -190,26 +378,53 @@ static bool AppInicializar(AppContext *ctx)
     ctx->telaAtual = TELA_MENU;
     ctx->solicitarEncerramento = false;
 
-    AtualizarNoAtualJogador(&ctx->jogador, ctx->mapa, MAP_L, MAP_C, ctx->tileW, ctx->tileH);
+    AtualizarRegioesMapa(ctx->mapa, ctx->jogador.posicao);
+    AtualizarTileAtualJogador(&ctx->jogador, ctx->mapa);
 
     ctx->camera.target = ctx->jogador.posicao;
     ctx->camera.offset = (Vector2){ larguraInicial / 2.0f, alturaInicial / 2.0f };
     ctx->camera.rotation = 0.0f;
     ctx->camera.zoom = 1.0f;
 
+    if (ctx->caminhoReproducao) {
+        ctx->caminhoGravacao = NULL;
+        if (!IniciarReproducao(ctx)) return false;
+    }
+
     return true;
 }
 
 static void AppFinalizar(AppContext *ctx)
 {
     if (!ctx) return;
+    Replay_Fechar(&ctx->replay);
     JogoLiberarRecursos(&ctx->estadoJogo);
     DescarregarTexturasEquipamentos();
     DescarregarJogador(&ctx->jogador);
     DescarregarTilesEMapa(ctx);
+    DescarregarTexturasMonstros();
+    EstatisticasTexturas estatTexturas = Texturas_Estatisticas();
+    printf("Cache de texturas: %d residentes (%d em %d paginas de atlas), %.1f KiB, %lu acertos, %lu falhas\n",
+           estatTexturas.texturasResidentes,
+           estatTexturas.spritesNoAtlas,
+           estatTexturas.paginasAtlas,
+           estatTexturas.bytesResidentes / 1024.0,
+           estatTexturas.acertos,
+           estatTexturas.falhas);
+    Texturas_Finalizar();
+    Pacote_Fechar();
+    Tarefas_Finalizar();
+    const Arena *rascunho = Rascunho_Estatisticas();
+    if (rascunho->falhas > 0) {
+        printf("Aviso: %d pedidos nao couberam na memoria de rascunho (%.1f KiB)\n",
+               rascunho->falhas, rascunho->capacidade / 1024.0);
+    }
+    Rascunho_Finalizar();
     if (ctx->fonteNormal.baseSize > 0) UnloadFont(ctx->fonteNormal);
     if (ctx->fonteBold.baseSize > 0) UnloadFont(ctx->fonteBold);
     if (IsWindowReady()) CloseWindow();
+    PERFIL_FINALIZAR_TRACE();
+    ALOCACOES_RELATORIO();
 }
 
 static void ProcessarTelaMenu(AppContext *ctx, Vector2 mousePos, bool mouseClique,
@@ -245,20 +460,12 @@ static void ProcessarTelaConfig(AppContext *ctx, Vector2 mousePos, bool mouseCli
     if (resultado.acao == MENU_ACAO_VOLTAR) {
         ctx->telaAtual = TELA_MENU;
     } else if (resultado.acao == MENU_ACAO_JOGAR) {
-        ctx->capaceteAtual = resultado.capacete;
-        ctx->armaduraAtual = resultado.armadura;
-        ctx->armaPrincipalAtual = resultado.armaPrincipal;
-        ctx->armaSecundariaAtual = resultado.armaSecundaria;
-        if (ctx->armaPrincipalAtual) ctx->armaPrincipalAtual->tempoRecargaRestante = 0.0f;
-        ctx->estadoJogo.regeneracaoAtual =
-            AtualizarVidaJogadorComEquipamentos(&ctx->jogador,
-                                                ctx->armaduraAtual,
-                                                ctx->capaceteAtual,
-                                                ctx->vidaBaseJogador,
-                                                ctx->armaPrincipalAtual);
-        ctx->jogador.vida = ctx->jogador.vidaMaxima;
-        JogoReiniciar(&ctx->estadoJogo, &ctx->jogador, &ctx->camera, ctx->posInicial);
-        ctx->telaAtual = TELA_JOGO;
+        IniciarPartida(ctx,
+                       resultado.capacete,
+                       resultado.armadura,
+                       resultado.armaPrincipal,
+                       resultado.armaSecundaria,
+                       Aleatorio_SementeNova());
     }
 }
 
@@ -286,34 +493,66 @@ static void ProcessarTelaJogo(AppContext *ctx,
                               int largura,
                               int altura)
 {
-    JogoAtualizar(&ctx->estadoJogo,
-                  &ctx->jogador,
-                  &ctx->camera,
-                  ctx->mapa,
-                  MAP_L,
-                  MAP_C,
-                  ctx->tileW,
-                  ctx->tileH,
-                  dt,
-                  mouseNoMundo,
-                  mouseCliqueEsq,
-                  mouseCliqueDir,
-                  escapePress,
-                  ctx->armaduraAtual,
-                  ctx->capaceteAtual,
-                  ctx->armaPrincipalAtual,
-                  ctx->armaSecundariaAtual);
+    // Eventos de um quadro valem só para o primeiro passo; se o quadro não
+    // executar nenhum passo eles ficam pendentes para o próximo.
+    EntradaJogo *entrada = &ctx->entradaPendente;
+    entrada->direcaoMovimento = LerDirecaoMovimentoTeclado();
+    entrada->mouseNoMundo = mouseNoMundo;
+    entrada->cliqueEsq = entrada->cliqueEsq || mouseCliqueEsq;
+    entrada->cliqueDir = entrada->cliqueDir || mouseCliqueDir;
+    entrada->pausar = entrada->pausar || escapePress;
+
+    const bool reproduzindo = Replay_Aberto(&ctx->replay) && !ctx->replay.gravando;
+    bool fimReproducao = false;
+
+    const float passo = ctx->passoSimulacao;
+    ctx->acumuladorSimulacao += dt;
+    int passos = 0;
+    PERFIL_INICIO(PERFIL_SIMULACAO);
+    while (ctx->acumuladorSimulacao >= passo && passos < MAX_PASSOS_POR_QUADRO) {
+        if (reproduzindo && !Replay_LerPasso(&ctx->replay, entrada)) {
+            fimReproducao = true;
+            break;
+        }
+        if (ctx->replay.gravando) Replay_GravarPasso(&ctx->replay, entrada);
+        ALOCACOES_INICIO("JogoAtualizar", ctx->estadoJogo.tempoTotalJogo);
+        JogoAtualizar(&ctx->estadoJogo,
+                      &ctx->jogador,
+                      &ctx->camera,
+                      ctx->mapa,
+                      ctx->mapa->linhas,
+                      ctx->mapa->colunas,
+                      ctx->tileW,
+                      ctx->tileH,
+                      passo,
+                      entrada,
+                      ctx->armaduraAtual,
+                      ctx->capaceteAtual,
+                      ctx->armaPrincipalAtual,
+                      ctx->armaSecundariaAtual);
+        ALOCACOES_FIM();
+        entrada->cliqueEsq = false;
+        entrada->cliqueDir = false;
+        entrada->pausar = false;
+        ctx->acumuladorSimulacao -= passo;
+        passos++;
+        if (ctx->estadoJogo.solicitouRetornoMenu || ctx->estadoJogo.jogadorMorto) break;
+    }
+    PERFIL_FIM(PERFIL_SIMULACAO);
+    if (ctx->acumuladorSimulacao >= passo) {
+        ctx->acumuladorSimulacao = fmodf(ctx->acumuladorSimulacao, passo);
+    }
+    float alfa = ctx->acumuladorSimulacao / passo;
+    bool estavaPausado = ctx->estadoJogo.pausado;
+    ALOCACOES_INICIO("JogoDesenhar", ctx->estadoJogo.tempoTotalJogo);
     JogoDesenhar(&ctx->estadoJogo,
                  &ctx->jogador,
                  &ctx->camera,
                  ctx->mapa,
+                 &ctx->camadaMapa,
                  ctx->tiles,
                  TOTAL_TILES,
                  ID_TILE_RUA,
-                 MAP_L,
-                 MAP_C,
-                 ctx->tileW,
-                 ctx->tileH,
                  largura,
                  altura,
                  ctx->fonteNormal,
@@ -323,14 +562,39 @@ static void ProcessarTelaJogo(AppContext *ctx,
                  ctx->armaPrincipalAtual,
                  ctx->armaSecundariaAtual,
                  mousePos,
-                 mouseCliqueEsq);
+                 mouseCliqueEsq && !reproduzindo,
+                 alfa);
+    ALOCACOES_FIM();
+
+    if (estavaPausado) {
+        // Cliques no menu de pausa não devem virar ataques quando o jogo retomar
+        entrada->cliqueEsq = false;
+        entrada->cliqueDir = false;
+        // "Retomar" passa pela entrada do próximo passo para que replays o reproduzam
+        if (!ctx->estadoJogo.pausado && !ctx->estadoJogo.solicitouRetornoMenu) {
+            ctx->estadoJogo.pausado = true;
+            entrada->pausar = true;
+        }
+    }
 
-    if (ctx->estadoJogo.solicitouRetornoMenu) {
+    bool fimPartida = fimReproducao || ctx->estadoJogo.solicitouRetornoMenu || ctx->estadoJogo.jogadorMorto;
+    if (fimPartida && Replay_Aberto(&ctx->replay)) {
+        if (reproduzindo) {
+            printf("Replay concluido: %u passos, %d pontos\n",
+                   (unsigned)ctx->replay.passosProcessados, ctx->estadoJogo.pontuacaoTotal);
+        }
+        Replay_Fechar(&ctx->replay);
+    }
+
+    if (fimReproducao) {
+        ctx->telaAtual = TELA_MENU;
+    } else if (ctx->estadoJogo.solicitouRetornoMenu) {
         ctx->estadoJogo.solicitouRetornoMenu = false;
         ctx->telaAtual = TELA_MENU;
     } else if (ctx->estadoJogo.jogadorMorto) {
         ctx->estadoJogo.jogadorMorto = false;
-        PontuacaoPrepararCadastro(&ctx->estadoPontuacao, ctx->estadoJogo.pontuacaoTotal);
+        PontuacaoPrepararCadastro(&ctx->estadoPontuacao, ctx->estadoJogo.pontuacaoTotal,
+                                  ctx->estadoJogo.semente);
         ctx->telaAtual = TELA_PONTUACAO;
     }
 }
@@ -348,9 +612,10 @@ static void ProcessarTelaPontuacao(AppContext *ctx,
                                                                largura,
                                                                altura);
     if (res.pontuacaoSalva) {
-        JogoReiniciar(&ctx->estadoJogo, &ctx->jogador, &ctx->camera, ctx->posInicial);
+        JogoReiniciar(&ctx->estadoJogo, &ctx->jogador, &ctx->camera, ctx->posInicial,
+                      Aleatorio_SementeNova());
         ctx->jogador.vida = ctx->jogador.vidaMaxima;
-        AtualizarNoAtualJogador(&ctx->jogador, ctx->mapa, MAP_L, MAP_C, ctx->tileW, ctx->tileH);
+        AtualizarTileAtualJogador(&ctx->jogador, ctx->mapa);
         ctx->telaAtual = TELA_MENU;
     }
 }
@@ -360,6 +625,8 @@ static void AppExecutarLoop(AppContext *ctx)
     while (!ctx->solicitarEncerramento) {
         if (WindowShouldClose()) break;
 
+        PERFIL_INICIO_QUADRO();
+        Rascunho_NovoQuadro();
         float dt = GetFrameTime();
         int largura = GetScreenWidth();
         int altura = GetScreenHeight();
@@ -371,6 +638,8 @@ static void AppExecutarLoop(AppContext *ctx)
         bool mouseCliqueEsq = IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
         bool mouseCliqueDir = IsMouseButtonPressed(MOUSE_BUTTON_RIGHT);
         bool escapePress = IsKeyPressed(KEY_ESCAPE);
+        if (IsKeyPressed(KEY_F3)) PERFIL_ALTERNAR_OVERLAY();
+        if (IsKeyPressed(KEY_F4)) PERFIL_DESCARREGAR_TRACE();
 
         BeginDrawing();
         ClearBackground((Color){12, 12, 26, 255});
@@ -393,20 +662,85 @@ static void AppExecutarLoop(AppContext *ctx)
                 ProcessarTelaPontuacao(ctx, mousePos, mouseCliqueEsq, largura, altura);
                 break;
         }
+        PERFIL_INICIO(PERFIL_APRESENTACAO);
         EndDrawing();
+        PERFIL_FIM(PERFIL_APRESENTACAO);
+        PERFIL_FIM_QUADRO();
 
         if (ctx->solicitarEncerramento) break;
     }
 }
 
-int AplicacaoExecutar(void)
+static int CompararDouble(const void *a, const void *b)
+{
+    double da = *(const double *)a;
+    double db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+// Percorre um círculo que cruza a borda do mapa desenhando só o chão, primeiro
+// tile a tile e depois pelos chunks. Sem vsync nem limite de FPS o EndDrawing
+// só bloqueia quando a GPU fica para trás, então o tempo de quadro acompanha
+// o custo de GPU.
+static void ExecutarBenchMapa(AppContext *ctx)
+{
+    static const char *NOMES_MODO[2] = { "tiles", "chunks" };
+    double tempos[QUADROS_BENCH_MAPA];
+    SetTargetFPS(0);
+
+    Vector2 centro = { ctx->mapa->colunas * ctx->tileW / 2.0f, ctx->mapa->linhas * ctx->tileH / 2.0f };
+    float raio = ctx->mapa->colunas * ctx->tileW * 0.6f;
+    printf("modo,quadros,desenhos_por_quadro,ms_medio,ms_p99\n");
+    for (int modo = 0; modo < 2; ++modo) {
+        if (modo == 1 && !ctx->camadaMapa.pronta) break;
+        long desenhos = 0;
+        int medidos = 0;
+        for (int q = -QUADROS_AQUECIMENTO_BENCH; q < QUADROS_BENCH_MAPA; ++q) {
+            if (WindowShouldClose()) break;
+            int largura = GetScreenWidth();
+            int altura = GetScreenHeight();
+            float angulo = 2.0f * PI * (float)q / QUADROS_BENCH_MAPA;
+            Camera2D camera = ctx->camera;
+            camera.offset = (Vector2){ largura / 2.0f, altura / 2.0f };
+            camera.target = (Vector2){ centro.x + cosf(angulo) * raio, centro.y + sinf(angulo) * raio };
+            AtualizarRegioesMapa(ctx->mapa, camera.target);
+
+            double inicio = GetTime();
+            BeginDrawing();
+            ClearBackground(BLACK);
+            BeginMode2D(camera);
+            int n = (modo == 0)
+                  ? DesenharMapaVisivel(&camera, largura, altura, ctx->mapa,
+                                        ctx->tiles, TOTAL_TILES, ID_TILE_RUA)
+                  : DesenharCamadaMapa(&ctx->camadaMapa, &camera, largura, altura);
+            EndMode2D();
+            EndDrawing();
+            if (q < 0) continue;
+            tempos[medidos++] = (GetTime() - inicio) * 1000.0;
+            desenhos += n;
+        }
+        if (medidos == 0) break;
+
+        double soma = 0.0;
+        for (int k = 0; k < medidos; ++k) soma += tempos[k];
+        qsort(tempos, (size_t)medidos, sizeof(double), CompararDouble);
+        printf("%s,%d,%.1f,%.3f,%.3f\n", NOMES_MODO[modo], medidos,
+               (double)desenhos / medidos, soma / medidos, tempos[(int)((medidos - 1) * 0.99)]);
+    }
+}
+
+int AplicacaoExecutar(int argc, char **argv)
 {
     AppContext ctx;
-    if (!AppInicializar(&ctx)) {
+    if (!AppInicializar(&ctx, argc, argv)) {
         AppFinalizar(&ctx);
         return 1;
     }
-    AppExecutarLoop(&ctx);
+    if (ctx.benchMapa) {
+        ExecutarBenchMapa(&ctx);
+    } else {
+        AppExecutarLoop(&ctx);
+    }
     AppFinalizar(&ctx);
     return 0;
 }
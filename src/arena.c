@@ -0,0 +1,59 @@
+#include "arena.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+bool Arena_Inicializar(Arena *arena, size_t capacidade)
+{
+    if (!arena) return false;
+    memset(arena, 0, sizeof(*arena));
+    capacidade = ARENA_TAMANHO(capacidade);
+    if (capacidade == 0) return true;
+    arena->base = (unsigned char *)malloc(capacidade);
+    if (!arena->base) {
+        printf("Erro: sem memoria para a arena (%zu bytes)\n", capacidade);
+        return false;
+    }
+    arena->capacidade = capacidade;
+    return true;
+}
+
+void Arena_Liberar(Arena *arena)
+{
+    if (!arena) return;
+    free(arena->base);
+    memset(arena, 0, sizeof(*arena));
+}
+
+void Arena_Resetar(Arena *arena)
+{
+    if (!arena) return;
+    arena->usado = 0;
+    arena->reservas = 0;
+}
+
+void *Arena_Alocar(Arena *arena, size_t tamanho)
+{
+    if (!arena || !arena->base) return NULL;
+    size_t ocupado = ARENA_TAMANHO(tamanho);
+    if (ocupado > arena->capacidade - arena->usado) {
+        arena->falhas++;
+        return NULL;
+    }
+    void *pedaco = arena->base + arena->usado;
+    arena->usado += ocupado;
+    if (arena->usado > arena->pico) arena->pico = arena->usado;
+    arena->reservas++;
+    return pedaco;
+}
+
+size_t Arena_Marca(const Arena *arena)
+{
+    return arena ? arena->usado : 0;
+}
+
+void Arena_Voltar(Arena *arena, size_t marca)
+{
+    if (!arena || marca > arena->usado) return;
+    arena->usado = marca;
+}
@@ -108,10 +108,10 @@ ArmaPrincipal *ObterArmaPrincipalPorNome(const char *nome) {
     return NULL;
 }
 
-static void DescarregarSeCarregado(Texture2D *tex) {
-    if (tex && tex->id != 0) {
-        UnloadTexture(*tex);
-        *tex = (Texture2D){0};
+static void DescarregarSeCarregado(IdTextura *tex) {
+    if (tex && *tex != TEXTURA_NENHUMA) {
+        Texturas_Liberar(*tex);
+        *tex = TEXTURA_NENHUMA;
     }
 }
 
@@ -134,14 +134,14 @@ static const char *BaseArmaPrincipal(const ArmaPrincipal *arma, char *buffer, si
     return GerarNomeSpriteArmaPrincipal(arma->nome, buffer, (int)tam);
 }
 
-static bool TentarCarregarFrame(Texture2D *destino, const char *dir, const char *base, const char *sufixo) {
+static bool TentarCarregarFrame(IdTextura *destino, const char *dir, const char *base, const char *sufixo) {
     char caminho[256];
     if (snprintf(caminho, sizeof(caminho), "%s%s%s.png", dir, base, sufixo) < 0) {
         return false;
     }
 
-    Texture2D sprite = LoadTexture(caminho);
-    if (sprite.id == 0) return false;
+    IdTextura sprite = Texturas_Carregar(caminho);
+    if (sprite == TEXTURA_NENHUMA) return false;
 
     *destino = sprite;
     return true;
@@ -188,26 +188,27 @@ void DescarregarSpritesArmaPrincipal(ArmaPrincipal *arma) {
 
 void DesenharArmaPrincipal(const ArmaPrincipal *arma, Vector2 posicaoCentroJogador,
                            bool emMovimento, bool frameAlternado, float escala) {
-    if (!arma || arma->spriteIdleOuFrame1.id == 0) return;
+    if (!arma || arma->spriteIdleOuFrame1 == TEXTURA_NENHUMA) return;
     if (escala <= 0.0f) escala = 1.0f;
 
-    const Texture2D *sprite = &arma->spriteIdleOuFrame1;
+    IdTextura idSprite = arma->spriteIdleOuFrame1;
     Vector2 offset = arma->offsetFrame1;
     if (emMovimento) {
-        if (arma->spriteFrame2.id != 0) {
-            sprite = frameAlternado ? &arma->spriteIdleOuFrame1 : &arma->spriteFrame2;
+        if (arma->spriteFrame2 != TEXTURA_NENHUMA) {
+            idSprite = frameAlternado ? arma->spriteIdleOuFrame1 : arma->spriteFrame2;
         }
         offset = frameAlternado ? arma->offsetFrame1 : arma->offsetFrame2;
     }
 
-    if (!sprite || sprite->id == 0) return;
+    SpriteTextura sprite = Texturas_ObterSprite(idSprite);
+    if (sprite.textura.id == 0) return;
 
     Vector2 posicao = {
-        posicaoCentroJogador.x - (sprite->width * escala) / 2.0f + offset.x * escala,
-        posicaoCentroJogador.y - (sprite->height * escala) / 2.0f + offset.y * escala
+        posicaoCentroJogador.x - (sprite.origem.width * escala) / 2.0f + offset.x * escala,
+        posicaoCentroJogador.y - (sprite.origem.height * escala) / 2.0f + offset.y * escala
     };
 
-    DrawTextureEx(*sprite, posicao, 0.0f, escala, WHITE);
+    Texturas_DesenharSprite(sprite, posicao, escala, WHITE);
 }
 
 static float ComprimentoVetor2(Vector2 v) {
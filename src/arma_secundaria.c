@@ -78,10 +78,10 @@ const ArmaSecundaria *ObterArmaSecundariaPorNome(const char *nome) {
     return NULL;
 }
 
-static void DescarregarSeCarregado(Texture2D *tex) {
-    if (tex && tex->id != 0) {
-        UnloadTexture(*tex);
-        *tex = (Texture2D){0};
+static void DescarregarSeCarregado(IdTextura *tex) {
+    if (tex && *tex != TEXTURA_NENHUMA) {
+        Texturas_Liberar(*tex);
+        *tex = TEXTURA_NENHUMA;
     }
 }
 
@@ -104,14 +104,14 @@ static const char *NomeArquivoArmaSecundaria(const ArmaSecundaria *hab, char *bu
     return GerarNomeSpriteArmaSecundaria(hab->nome, buffer, (int)tamanhoBuffer);
 }
 
-static bool TentarCarregarFrame(Texture2D *destino, const char *dir, const char *base, const char *sufixo) {
+static bool TentarCarregarFrame(IdTextura *destino, const char *dir, const char *base, const char *sufixo) {
     char caminho[256];
     if (snprintf(caminho, sizeof(caminho), "%s%s%s.png", dir, base, sufixo) < 0) {
         return false;
     }
 
-    Texture2D sprite = LoadTexture(caminho);
-    if (sprite.id == 0) return false;
+    IdTextura sprite = Texturas_Carregar(caminho);
+    if (sprite == TEXTURA_NENHUMA) return false;
 
     *destino = sprite;
     return true;
@@ -148,23 +148,26 @@ void DescarregarSpritesArmaSecundaria(ArmaSecundaria *hab) {
 
 void DesenharArmaSecundaria(const ArmaSecundaria *hab, Vector2 posicaoCentro,
                                   bool emMovimento, bool frameAlternado, float escala) {
-    if (!hab || hab->spriteIdleOuFrame1.id == 0) return;
+    if (!hab || hab->spriteIdleOuFrame1 == TEXTURA_NENHUMA) return;
     if (escala <= 0.0f) escala = 1.0f;
 
-    const Texture2D *sprite = &hab->spriteIdleOuFrame1;
+    IdTextura idSprite = hab->spriteIdleOuFrame1;
     Vector2 offset = hab->offsetFrame1;
 
     if (emMovimento) {
-        if (hab->spriteFrame2.id != 0) {
-            sprite = frameAlternado ? &hab->spriteFrame2 : &hab->spriteIdleOuFrame1;
+        if (hab->spriteFrame2 != TEXTURA_NENHUMA) {
+            idSprite = frameAlternado ? hab->spriteFrame2 : hab->spriteIdleOuFrame1;
         }
         offset = frameAlternado ? hab->offsetFrame2 : hab->offsetFrame1;
     }
 
+    SpriteTextura sprite = Texturas_ObterSprite(idSprite);
+    if (sprite.textura.id == 0) return;
+
     Vector2 posicao = {
-        posicaoCentro.x - (sprite->width * escala) / 2.0f + offset.x * escala,
-        posicaoCentro.y - (sprite->height * escala) / 2.0f + offset.y * escala
+        posicaoCentro.x - (sprite.origem.width * escala) / 2.0f + offset.x * escala,
+        posicaoCentro.y - (sprite.origem.height * escala) / 2.0f + offset.y * escala
     };
 
-    DrawTextureEx(*sprite, posicao, 0.0f, escala, WHITE);
+    Texturas_DesenharSprite(sprite, posicao, escala, WHITE);
 }
@@ -69,10 +69,10 @@ Armadura *ObterArmaduraPorNome(const char *nome) {
     return NULL;
 }
 
-static void DescarregarSeCarregado(Texture2D *tex) {
-    if (tex && tex->id != 0) {
-        UnloadTexture(*tex);
-        *tex = (Texture2D){0};
+static void DescarregarSeCarregado(IdTextura *tex) {
+    if (tex && *tex != TEXTURA_NENHUMA) {
+        Texturas_Liberar(*tex);
+        *tex = TEXTURA_NENHUMA;
     }
 }
 
@@ -95,14 +95,14 @@ static const char *BaseArmadura(const Armadura *arm, char *buffer, size_t tam) {
     return GerarNomeSpriteArmadura(arm->nome, buffer, (int)tam);
 }
 
-static bool CarregarSpriteUnico(Texture2D *destino, const char *dir, const char *base, const char *sufixo) {
+static bool CarregarSpriteUnico(IdTextura *destino, const char *dir, const char *base, const char *sufixo) {
     char caminho[256];
     if (snprintf(caminho, sizeof(caminho), "%s%s%s.png", dir, base, sufixo) < 0) {
         return false;
     }
 
-    Texture2D sprite = LoadTexture(caminho);
-    if (sprite.id == 0) {
+    IdTextura sprite = Texturas_Carregar(caminho);
+    if (sprite == TEXTURA_NENHUMA) {
         return false;
     }
 
@@ -149,17 +149,18 @@ void DesenharArmadura(const Armadura *arm, Vector2 posicaoCentroJogador,
     if (!arm) return;
     if (escala <= 0.0f) escala = 1.0f;
 
-    const Texture2D *sprite = &arm->spriteIdle;
+    IdTextura idSprite = arm->spriteIdle;
     if (emMovimento) {
-        sprite = frameAlternado ? &arm->spriteAndando1 : &arm->spriteAndando2;
+        idSprite = frameAlternado ? arm->spriteAndando1 : arm->spriteAndando2;
     }
 
-    if (!sprite || sprite->id == 0) return;
+    SpriteTextura sprite = Texturas_ObterSprite(idSprite);
+    if (sprite.textura.id == 0) return;
 
     Vector2 posicao = {
-        posicaoCentroJogador.x - (sprite->width * escala) / 2.0f,
-        posicaoCentroJogador.y - (sprite->height * escala) / 2.0f
+        posicaoCentroJogador.x - (sprite.origem.width * escala) / 2.0f,
+        posicaoCentroJogador.y - (sprite.origem.height * escala) / 2.0f
     };
 
-    DrawTextureEx(*sprite, posicao, 0.0f, escala, WHITE);
+    Texturas_DesenharSprite(sprite, posicao, escala, WHITE);
 }
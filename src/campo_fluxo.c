@@ -0,0 +1,253 @@
+#include "campo_fluxo.h"
+#include "mapa.h"
+#include "arena.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DISTANCIA_INFINITA 0xFFFF
+#define DIRECAO_RETA 8
+#define DIRECAO_SEM_CAMINHO 254
+#define DIRECAO_BLOQUEADA 255
+
+// Vizinhos na ordem de preferência em empates: ortogonais, depois diagonais
+static const int VIZINHO_LINHA[8]  = { -1, 1, 0, 0, -1, -1, 1, 1 };
+static const int VIZINHO_COLUNA[8] = { 0, 0, -1, 1, -1, 1, -1, 1 };
+
+void CampoFluxo_Liberar(CampoFluxo *campo)
+{
+    if (!campo) return;
+    if (!campo->memoriaFixa) {
+        free(campo->distancia);
+        free(campo->direcao);
+        free(campo->fila);
+    }
+    memset(campo, 0, sizeof(*campo));
+    campo->alvoLinha = -1;
+    campo->alvoColuna = -1;
+}
+
+void CampoFluxo_Invalidar(CampoFluxo *campo)
+{
+    if (!campo) return;
+    campo->alvoLinha = -1;
+    campo->alvoColuna = -1;
+}
+
+size_t CampoFluxo_TamanhoArena(int tiles)
+{
+    return ARENA_TAMANHO((size_t)tiles * sizeof(uint16_t)) +
+           ARENA_TAMANHO((size_t)tiles) +
+           ARENA_TAMANHO((size_t)tiles * sizeof(int));
+}
+
+bool CampoFluxo_ReservarArena(CampoFluxo *campo, int tiles, Arena *arena)
+{
+    if (!campo || !arena || tiles < 1) return false;
+    memset(campo, 0, sizeof(*campo));
+    campo->alvoLinha = -1;
+    campo->alvoColuna = -1;
+    campo->memoriaFixa = true;
+    campo->distancia = (uint16_t *)Arena_Alocar(arena, (size_t)tiles * sizeof(uint16_t));
+    campo->direcao = (uint8_t *)Arena_Alocar(arena, (size_t)tiles);
+    campo->fila = (int *)Arena_Alocar(arena, (size_t)tiles * sizeof(int));
+    if (!campo->distancia || !campo->direcao || !campo->fila) {
+        campo->distancia = NULL;
+        campo->direcao = NULL;
+        campo->fila = NULL;
+        return false;
+    }
+    campo->capacidade = tiles;
+    return true;
+}
+
+static bool GarantirCapacidade(CampoFluxo *campo, int total)
+{
+    if (total <= campo->capacidade) return true;
+    if (campo->memoriaFixa) return false;
+    uint16_t *distancia = (uint16_t *)malloc((size_t)total * sizeof(uint16_t));
+    uint8_t *direcao = (uint8_t *)malloc((size_t)total);
+    int *fila = (int *)malloc((size_t)total * sizeof(int));
+    if (!distancia || !direcao || !fila) {
+        free(distancia);
+        free(direcao);
+        free(fila);
+        return false;
+    }
+    free(campo->distancia);
+    free(campo->direcao);
+    free(campo->fila);
+    campo->distancia = distancia;
+    campo->direcao = direcao;
+    campo->fila = fila;
+    campo->capacidade = total;
+    return true;
+}
+
+static int InicioJanela(int alvo, int tamanho, int total)
+{
+    int inicio = alvo - tamanho / 2;
+    if (inicio > total - tamanho) inicio = total - tamanho;
+    if (inicio < 0) inicio = 0;
+    return inicio;
+}
+
+static void CalcularDistancias(CampoFluxo *campo, int alvo)
+{
+    const int colunas = campo->colunas;
+    const int total = campo->linhas * colunas;
+    for (int k = 0; k < total; ++k) campo->distancia[k] = DISTANCIA_INFINITA;
+
+    int inicio = 0, fim = 0;
+    campo->distancia[alvo] = 0;
+    campo->fila[fim++] = alvo;
+    while (inicio < fim) {
+        int k = campo->fila[inicio++];
+        int i = k / colunas, j = k % colunas;
+        uint16_t proxima = (uint16_t)(campo->distancia[k] + 1);
+        for (int v = 0; v < 4; ++v) {
+            int ni = i + VIZINHO_LINHA[v], nj = j + VIZINHO_COLUNA[v];
+            if (ni < 0 || nj < 0 || ni >= campo->linhas || nj >= colunas) continue;
+            int n = ni * colunas + nj;
+            if (campo->direcao[n] == DIRECAO_BLOQUEADA || campo->distancia[n] != DISTANCIA_INFINITA) continue;
+            campo->distancia[n] = proxima;
+            campo->fila[fim++] = n;
+        }
+    }
+}
+
+static bool Livre(const CampoFluxo *campo, int i, int j)
+{
+    return i >= 0 && j >= 0 && i < campo->linhas && j < campo->colunas &&
+           campo->direcao[i * campo->colunas + j] != DIRECAO_BLOQUEADA;
+}
+
+// Vizinho alcançável mais perto do alvo; diagonais só sem cortar quina
+static uint8_t MelhorVizinho(const CampoFluxo *campo, int i, int j)
+{
+    uint8_t melhor = DIRECAO_SEM_CAMINHO;
+    uint16_t menor = campo->distancia[i * campo->colunas + j];
+    for (int v = 0; v < 8; ++v) {
+        int ni = i + VIZINHO_LINHA[v], nj = j + VIZINHO_COLUNA[v];
+        if (!Livre(campo, ni, nj)) continue;
+        if (v >= 4 && (!Livre(campo, ni, j) || !Livre(campo, i, nj))) continue;
+        uint16_t d = campo->distancia[ni * campo->colunas + nj];
+        if (d < menor) {
+            menor = d;
+            melhor = (uint8_t)v;
+        }
+    }
+    return melhor;
+}
+
+static int Sinal(int v)
+{
+    return (v > 0) - (v < 0);
+}
+
+// Percorre as linhas e, dentro delas, as colunas do alvo para fora: os dois
+// vizinhos na direção do alvo já foram decididos quando cada tile é visitado.
+// Linha de visão = tile livre cujos vizinhos rumo ao alvo também têm, isto é,
+// todo o retângulo entre o tile e o alvo está livre e alcançável.
+static void CalcularDirecoes(CampoFluxo *campo, int alvoI, int alvoJ)
+{
+    const int colunas = campo->colunas;
+    for (int di = 0; di < campo->linhas; ++di) {
+        for (int ladoI = -1; ladoI <= 1; ladoI += 2) {
+            int i = alvoI + ladoI * di;
+            if ((di == 0 && ladoI > 0) || i < 0 || i >= campo->linhas) continue;
+            for (int dj = 0; dj < colunas; ++dj) {
+                for (int ladoJ = -1; ladoJ <= 1; ladoJ += 2) {
+                    int j = alvoJ + ladoJ * dj;
+                    if ((dj == 0 && ladoJ > 0) || j < 0 || j >= colunas) continue;
+                    int k = i * colunas + j;
+                    if (campo->direcao[k] == DIRECAO_BLOQUEADA) continue;
+                    if (campo->distancia[k] == DISTANCIA_INFINITA) {
+                        campo->direcao[k] = DIRECAO_SEM_CAMINHO;
+                        continue;
+                    }
+                    bool reta = true;
+                    if (i != alvoI) reta = campo->direcao[(i - Sinal(i - alvoI)) * colunas + j] == DIRECAO_RETA;
+                    if (reta && j != alvoJ) reta = campo->direcao[i * colunas + j - Sinal(j - alvoJ)] == DIRECAO_RETA;
+                    campo->direcao[k] = reta ? DIRECAO_RETA : MelhorVizinho(campo, i, j);
+                }
+            }
+        }
+    }
+}
+
+bool CampoFluxo_Atualizar(CampoFluxo *campo, const Mapa *mapa, int linhaAlvo, int colunaAlvo)
+{
+    if (!campo || !mapa || linhaAlvo < 0 || colunaAlvo < 0) return false;
+
+    // Em mapas de arquivo a janela fica dentro das regiões garantidas
+    // residentes: o campo não depende de quando a leitura de fundo terminou e
+    // é refeito quando essa área muda, mesmo com o alvo no mesmo tile
+    int areaLinha, areaColuna, areaLinhas, areaColunas;
+    AreaResidenteMapa(mapa, &areaLinha, &areaColuna, &areaLinhas, &areaColunas);
+    if (linhaAlvo < areaLinha || colunaAlvo < areaColuna ||
+        linhaAlvo >= areaLinha + areaLinhas || colunaAlvo >= areaColuna + areaColunas) {
+        CampoFluxo_Invalidar(campo);
+        return false;
+    }
+    int linhas = areaLinhas < CAMPO_FLUXO_JANELA ? areaLinhas : CAMPO_FLUXO_JANELA;
+    int colunas = areaColunas < CAMPO_FLUXO_JANELA ? areaColunas : CAMPO_FLUXO_JANELA;
+    int origemLinha = areaLinha + InicioJanela(linhaAlvo - areaLinha, linhas, areaLinhas);
+    int origemColuna = areaColuna + InicioJanela(colunaAlvo - areaColuna, colunas, areaColunas);
+    if (linhaAlvo == campo->alvoLinha && colunaAlvo == campo->alvoColuna &&
+        origemLinha == campo->origemLinha && origemColuna == campo->origemColuna &&
+        linhas == campo->linhas && colunas == campo->colunas) {
+        return false;
+    }
+
+    if (!GarantirCapacidade(campo, linhas * colunas)) {
+        CampoFluxo_Invalidar(campo);
+        return false;
+    }
+    campo->linhas = linhas;
+    campo->colunas = colunas;
+    campo->origemLinha = origemLinha;
+    campo->origemColuna = origemColuna;
+    campo->tileLargura = mapa->tileLargura;
+    campo->tileAltura = mapa->tileAltura;
+    campo->alvoLinha = linhaAlvo;
+    campo->alvoColuna = colunaAlvo;
+
+    // Antes das direções, `direcao` marca só os tiles bloqueados. Um tile sem
+    // região residente (não deveria haver na área garantida) conta como livre:
+    // uma parede falsa é pior que um caminho que bate numa parede real
+    for (int i = 0; i < linhas; ++i) {
+        for (int j = 0; j < colunas; ++j) {
+            int linha = campo->origemLinha + i, coluna = campo->origemColuna + j;
+            bool colide = IdTileMapa(mapa, linha, coluna) >= 0 && TilePossuiColisao(mapa, linha, coluna);
+            campo->direcao[i * colunas + j] = colide ? DIRECAO_BLOQUEADA : DIRECAO_SEM_CAMINHO;
+        }
+    }
+    int alvoI = linhaAlvo - campo->origemLinha;
+    int alvoJ = colunaAlvo - campo->origemColuna;
+    CalcularDistancias(campo, alvoI * colunas + alvoJ);
+    CalcularDirecoes(campo, alvoI, alvoJ);
+    return true;
+}
+
+bool CampoFluxo_Desvio(const CampoFluxo *campo, Vector2 posicao, Vector2 *direcao)
+{
+    if (!campo || campo->alvoLinha < 0 || campo->tileLargura <= 0 || campo->tileAltura <= 0) return false;
+    int i = (int)floorf(posicao.y / campo->tileAltura) - campo->origemLinha;
+    int j = (int)floorf(posicao.x / campo->tileLargura) - campo->origemColuna;
+    if (i < 0 || j < 0 || i >= campo->linhas || j >= campo->colunas) return false;
+
+    uint8_t codigo = campo->direcao[i * campo->colunas + j];
+    if (codigo >= DIRECAO_RETA) return false;
+
+    // Mira no centro do vizinho: quem anda rente a uma parede não a atravessa
+    float alvoX = (campo->origemColuna + j + VIZINHO_COLUNA[codigo] + 0.5f) * campo->tileLargura;
+    float alvoY = (campo->origemLinha + i + VIZINHO_LINHA[codigo] + 0.5f) * campo->tileAltura;
+    float dx = alvoX - posicao.x;
+    float dy = alvoY - posicao.y;
+    float comprimento = sqrtf(dx * dx + dy * dy);
+    if (comprimento <= 0.01f) return false;
+    direcao->x = dx / comprimento;
+    direcao->y = dy / comprimento;
+    return true;
+}
@@ -79,13 +79,13 @@ bool CarregarSpriteCapacete(Capacete *cap, const char *diretorioSprites) {
     const char *dir = diretorioSprites ? diretorioSprites : DIRETORIO_PADRAO_CAPACETES;
     if (snprintf(caminho, sizeof(caminho), "%s%s.png", dir, basename) < 0) return false;
 
-    if (cap->sprite.id != 0) {
-        UnloadTexture(cap->sprite);
-        cap->sprite = (Texture2D){0};
+    if (cap->sprite != TEXTURA_NENHUMA) {
+        Texturas_Liberar(cap->sprite);
+        cap->sprite = TEXTURA_NENHUMA;
     }
 
-    Texture2D sprite = LoadTexture(caminho);
-    if (sprite.id == 0) {
+    IdTextura sprite = Texturas_Carregar(caminho);
+    if (sprite == TEXTURA_NENHUMA) {
         return false;
     }
     cap->sprite = sprite;
@@ -94,21 +94,22 @@ bool CarregarSpriteCapacete(Capacete *cap, const char *diretorioSprites) {
 
 void DescarregarSpriteCapacete(Capacete *cap) {
     if (!cap) return;
-    if (cap->sprite.id != 0) {
-        UnloadTexture(cap->sprite);
-        cap->sprite = (Texture2D){0};
+    if (cap->sprite != TEXTURA_NENHUMA) {
+        Texturas_Liberar(cap->sprite);
+        cap->sprite = TEXTURA_NENHUMA;
     }
 }
 
 void DesenharCapacete(const Capacete *cap, Vector2 posicaoCentroJogador, float escala) {
-    if (!cap || cap->sprite.id == 0) return;
+    if (!cap || cap->sprite == TEXTURA_NENHUMA) return;
     if (escala <= 0.0f) escala = 1.0f;
 
-    const Texture2D sprite = cap->sprite;
+    const SpriteTextura sprite = Texturas_ObterSprite(cap->sprite);
+    if (sprite.textura.id == 0) return;
     Vector2 posicao = {
-        posicaoCentroJogador.x - (sprite.width * escala) / 2.0f,
-        posicaoCentroJogador.y - (sprite.height * escala) / 2.0f
+        posicaoCentroJogador.x - (sprite.origem.width * escala) / 2.0f,
+        posicaoCentroJogador.y - (sprite.origem.height * escala) / 2.0f
     };
 
-    DrawTextureEx(sprite, posicao, 0.0f, escala, WHITE);
+    Texturas_DesenharSprite(sprite, posicao, escala, WHITE);
 }
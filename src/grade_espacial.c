@@ -0,0 +1,318 @@
+#include "grade_espacial.h"
+#include "testes_acerto.h"
+#include "arena.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Pontos testados por chamada de kernel (tamanho da máscara na pilha)
+#define LOTE_TESTE 128
+
+typedef struct {
+    float minX, minY, maxX, maxY;
+} Caixa;
+
+typedef enum { TESTE_CIRCULO, TESTE_CONE, TESTE_CAPSULA } FormaTeste;
+
+typedef struct {
+    FormaTeste forma;
+    Vector2 centro;
+    float raio;
+    ConeAcerto cone;
+    CapsulaAcerto capsula;
+} TesteExato;
+
+static int LimitarInt(int valor, int minimo, int maximo)
+{
+    if (valor < minimo) return minimo;
+    if (valor > maximo) return maximo;
+    return valor;
+}
+
+static int ColunaDaPosicao(const GradeEspacial *g, float x)
+{
+    return LimitarInt((int)floorf((x - g->origemX) / g->tamanhoCelula), 0, g->colunas - 1);
+}
+
+static int LinhaDaPosicao(const GradeEspacial *g, float y)
+{
+    return LimitarInt((int)floorf((y - g->origemY) / g->tamanhoCelula), 0, g->linhas - 1);
+}
+
+bool GradeEspacial_Configurar(GradeEspacial *g, float origemX, float origemY,
+                              float largura, float altura, float tamanhoCelula)
+{
+    if (!g || tamanhoCelula <= 0.0f || largura <= 0.0f || altura <= 0.0f) return false;
+
+    int colunas = (int)ceilf(largura / tamanhoCelula);
+    int linhas = (int)ceilf(altura / tamanhoCelula);
+    if (colunas < 1) colunas = 1;
+    if (linhas < 1) linhas = 1;
+
+    if (g->inicioCelula && g->colunas == colunas && g->linhas == linhas) {
+        g->origemX = origemX;
+        g->origemY = origemY;
+        g->tamanhoCelula = tamanhoCelula;
+        return true;
+    }
+
+    if (g->memoriaFixa) {
+        if ((long)colunas * linhas + 1 > g->capacidadeCelulas) return false;
+        memset(g->inicioCelula, 0, ((size_t)colunas * linhas + 1) * sizeof(int));
+        g->origemX = origemX;
+        g->origemY = origemY;
+        g->tamanhoCelula = tamanhoCelula;
+        g->colunas = colunas;
+        g->linhas = linhas;
+        g->quantidade = 0;
+        return true;
+    }
+
+    int *inicio = (int *)calloc((size_t)colunas * linhas + 1, sizeof(int));
+    if (!inicio) return false;
+    free(g->inicioCelula);
+    g->inicioCelula = inicio;
+    g->origemX = origemX;
+    g->origemY = origemY;
+    g->tamanhoCelula = tamanhoCelula;
+    g->colunas = colunas;
+    g->linhas = linhas;
+    g->quantidade = 0;
+    return true;
+}
+
+size_t GradeEspacial_TamanhoArena(int celulas, int capacidade)
+{
+    return ARENA_TAMANHO(((size_t)celulas + 1) * sizeof(int)) +
+           3 * ARENA_TAMANHO((size_t)capacidade * sizeof(int)) +
+           4 * ARENA_TAMANHO((size_t)capacidade * sizeof(float));
+}
+
+bool GradeEspacial_ReservarArena(GradeEspacial *g, int celulas, int capacidade, Arena *arena)
+{
+    if (!g || !arena || celulas < 1 || capacidade < 1) return false;
+    memset(g, 0, sizeof(*g));
+    g->memoriaFixa = true;
+    g->inicioCelula = (int *)Arena_Alocar(arena, ((size_t)celulas + 1) * sizeof(int));
+    g->indices = (int *)Arena_Alocar(arena, (size_t)capacidade * sizeof(int));
+    g->posX = (float *)Arena_Alocar(arena, (size_t)capacidade * sizeof(float));
+    g->posY = (float *)Arena_Alocar(arena, (size_t)capacidade * sizeof(float));
+    g->celulaPendente = (int *)Arena_Alocar(arena, (size_t)capacidade * sizeof(int));
+    g->indicePendente = (int *)Arena_Alocar(arena, (size_t)capacidade * sizeof(int));
+    g->xPendente = (float *)Arena_Alocar(arena, (size_t)capacidade * sizeof(float));
+    g->yPendente = (float *)Arena_Alocar(arena, (size_t)capacidade * sizeof(float));
+    if (!g->inicioCelula || !g->indices || !g->posX || !g->posY || !g->celulaPendente ||
+        !g->indicePendente || !g->xPendente || !g->yPendente) {
+        memset(g, 0, sizeof(*g));
+        g->memoriaFixa = true;
+        return false;
+    }
+    // Até o primeiro Configurar é uma grade vazia de uma célula
+    g->capacidadeCelulas = celulas + 1;
+    g->capacidade = capacidade;
+    g->colunas = 1;
+    g->linhas = 1;
+    g->tamanhoCelula = 1.0f;
+    g->inicioCelula[0] = 0;
+    g->inicioCelula[1] = 0;
+    return true;
+}
+
+void GradeEspacial_Liberar(GradeEspacial *g)
+{
+    if (!g) return;
+    if (g->memoriaFixa) {
+        memset(g, 0, sizeof(*g));
+        return;
+    }
+    free(g->inicioCelula);
+    free(g->indices);
+    free(g->posX);
+    free(g->posY);
+    free(g->celulaPendente);
+    free(g->indicePendente);
+    free(g->xPendente);
+    free(g->yPendente);
+    memset(g, 0, sizeof(*g));
+}
+
+static bool GarantirCapacidade(GradeEspacial *g, int minimo)
+{
+    if (minimo <= g->capacidade) return true;
+    if (g->memoriaFixa) return false;
+    int nova = g->capacidade > 0 ? g->capacidade * 2 : 128;
+    while (nova < minimo) nova *= 2;
+
+    int *indices = (int *)realloc(g->indices, (size_t)nova * sizeof(int));
+    if (indices) g->indices = indices;
+    float *posX = (float *)realloc(g->posX, (size_t)nova * sizeof(float));
+    if (posX) g->posX = posX;
+    float *posY = (float *)realloc(g->posY, (size_t)nova * sizeof(float));
+    if (posY) g->posY = posY;
+    int *celula = (int *)realloc(g->celulaPendente, (size_t)nova * sizeof(int));
+    if (celula) g->celulaPendente = celula;
+    int *indice = (int *)realloc(g->indicePendente, (size_t)nova * sizeof(int));
+    if (indice) g->indicePendente = indice;
+    float *x = (float *)realloc(g->xPendente, (size_t)nova * sizeof(float));
+    if (x) g->xPendente = x;
+    float *y = (float *)realloc(g->yPendente, (size_t)nova * sizeof(float));
+    if (y) g->yPendente = y;
+
+    if (!indices || !posX || !posY || !celula || !indice || !x || !y) return false;
+    g->capacidade = nova;
+    return true;
+}
+
+void GradeEspacial_Limpar(GradeEspacial *g)
+{
+    if (!g) return;
+    g->quantidade = 0;
+    if (g->inicioCelula) {
+        memset(g->inicioCelula, 0, ((size_t)g->colunas * g->linhas + 1) * sizeof(int));
+    }
+}
+
+bool GradeEspacial_Inserir(GradeEspacial *g, int indice, Vector2 posicao)
+{
+    if (!g || !g->inicioCelula) return false;
+    if (!GarantirCapacidade(g, g->quantidade + 1)) return false;
+    int n = g->quantidade++;
+    g->celulaPendente[n] = LinhaDaPosicao(g, posicao.y) * g->colunas + ColunaDaPosicao(g, posicao.x);
+    g->indicePendente[n] = indice;
+    g->xPendente[n] = posicao.x;
+    g->yPendente[n] = posicao.y;
+    return true;
+}
+
+void GradeEspacial_Finalizar(GradeEspacial *g)
+{
+    if (!g || !g->inicioCelula) return;
+    int totalCelulas = g->colunas * g->linhas;
+    int *inicio = g->inicioCelula;
+
+    memset(inicio, 0, ((size_t)totalCelulas + 1) * sizeof(int));
+    for (int i = 0; i < g->quantidade; ++i) {
+        inicio[g->celulaPendente[i] + 1]++;
+    }
+    for (int c = 0; c < totalCelulas; ++c) {
+        inicio[c + 1] += inicio[c];
+    }
+    // Espalha usando inicio[c] como cursor e depois desloca de volta
+    for (int i = 0; i < g->quantidade; ++i) {
+        int destino = inicio[g->celulaPendente[i]]++;
+        g->indices[destino] = g->indicePendente[i];
+        g->posX[destino] = g->xPendente[i];
+        g->posY[destino] = g->yPendente[i];
+    }
+    for (int c = totalCelulas; c > 0; --c) {
+        inicio[c] = inicio[c - 1];
+    }
+    inicio[0] = 0;
+}
+
+// As células de uma linha entre c0 e c1 ocupam um trecho contíguo de
+// posX/posY: cada trecho vai inteiro para o kernel e só os índices que
+// acertaram são copiados, na mesma ordem das células
+static int FiltrarCaixa(const GradeEspacial *g, Caixa caixa, const TesteExato *teste,
+                        int *saida, int capacidade)
+{
+    int c0 = ColunaDaPosicao(g, caixa.minX);
+    int c1 = ColunaDaPosicao(g, caixa.maxX);
+    int l0 = LinhaDaPosicao(g, caixa.minY);
+    int l1 = LinhaDaPosicao(g, caixa.maxY);
+    uint8_t mascara[LOTE_TESTE];
+
+    int escritos = 0;
+    for (int l = l0; l <= l1; ++l) {
+        int ini = g->inicioCelula[l * g->colunas + c0];
+        int fim = g->inicioCelula[l * g->colunas + c1 + 1];
+        for (int k = ini; k < fim; k += LOTE_TESTE) {
+            int n = (fim - k < LOTE_TESTE) ? fim - k : LOTE_TESTE;
+            int acertos = 0;
+            switch (teste->forma) {
+                case TESTE_CIRCULO:
+                    acertos = TestesAcerto_Circulo(g->posX + k, g->posY + k, n, teste->centro, teste->raio, mascara);
+                    break;
+                case TESTE_CONE:
+                    acertos = TestesAcerto_Cone(g->posX + k, g->posY + k, n, &teste->cone, mascara);
+                    break;
+                case TESTE_CAPSULA:
+                    acertos = TestesAcerto_Capsula(g->posX + k, g->posY + k, n, &teste->capsula, mascara);
+                    break;
+            }
+            if (acertos == 0) continue;
+            for (int m = 0; m < n; ++m) {
+                if (!mascara[m]) continue;
+                if (escritos >= capacidade) return escritos;
+                saida[escritos++] = g->indices[k + m];
+            }
+        }
+    }
+    return escritos;
+}
+
+// AABB do setor (origem, bordas e extremos cardeais contidos no arco)
+static Caixa CaixaCone(Vector2 origem, Vector2 direcao, float alcance, float aberturaGraus, float raioExtra)
+{
+    float raio = alcance + raioExtra;
+    Caixa caixa = { origem.x, origem.y, origem.x, origem.y };
+    float meia = aberturaGraus * 0.5f * DEG2RAD;
+    if (meia >= PI) {
+        caixa = (Caixa){ origem.x - raio, origem.y - raio, origem.x + raio, origem.y + raio };
+    } else {
+        float angulo = atan2f(direcao.y, direcao.x);
+        float extremos[2] = { angulo - meia, angulo + meia };
+        for (int i = 0; i < 2; ++i) {
+            float x = origem.x + cosf(extremos[i]) * raio;
+            float y = origem.y + sinf(extremos[i]) * raio;
+            caixa.minX = fminf(caixa.minX, x); caixa.maxX = fmaxf(caixa.maxX, x);
+            caixa.minY = fminf(caixa.minY, y); caixa.maxY = fmaxf(caixa.maxY, y);
+        }
+        for (int k = -4; k <= 4; ++k) {
+            float cardeal = k * (PI * 0.5f);
+            if (cardeal < extremos[0] || cardeal > extremos[1]) continue;
+            float x = origem.x + cosf(cardeal) * raio;
+            float y = origem.y + sinf(cardeal) * raio;
+            caixa.minX = fminf(caixa.minX, x); caixa.maxX = fmaxf(caixa.maxX, x);
+            caixa.minY = fminf(caixa.minY, y); caixa.maxY = fmaxf(caixa.maxY, y);
+        }
+    }
+    caixa.minX -= raioExtra; caixa.maxX += raioExtra;
+    caixa.minY -= raioExtra; caixa.maxY += raioExtra;
+    return caixa;
+}
+
+int GradeEspacial_ConsultarCirculo(const GradeEspacial *g, Vector2 centro, float raio,
+                                   int *saida, int capacidade)
+{
+    if (!g || !g->inicioCelula || !saida || capacidade <= 0 || raio < 0.0f) return 0;
+    TesteExato teste = { .forma = TESTE_CIRCULO, .centro = centro, .raio = raio };
+    Caixa caixa = { centro.x - raio, centro.y - raio, centro.x + raio, centro.y + raio };
+    return FiltrarCaixa(g, caixa, &teste, saida, capacidade);
+}
+
+int GradeEspacial_ConsultarCone(const GradeEspacial *g, Vector2 origem, Vector2 direcao,
+                                float alcance, float aberturaGraus, float raioExtra,
+                                int *saida, int capacidade)
+{
+    if (!g || !g->inicioCelula || !saida || capacidade <= 0) return 0;
+    if (raioExtra < 0.0f) raioExtra = 0.0f;
+    TesteExato teste = { .forma = TESTE_CONE };
+    teste.cone = TestesAcerto_PrepararCone(origem, direcao, alcance, aberturaGraus, raioExtra);
+    Caixa caixa = CaixaCone(origem, direcao, alcance, aberturaGraus, raioExtra);
+    return FiltrarCaixa(g, caixa, &teste, saida, capacidade);
+}
+
+int GradeEspacial_ConsultarCapsula(const GradeEspacial *g, Vector2 inicio, Vector2 fim,
+                                   float raio, int *saida, int capacidade)
+{
+    if (!g || !g->inicioCelula || !saida || capacidade <= 0) return 0;
+    if (raio < 0.0f) raio = 0.0f;
+    TesteExato teste = { .forma = TESTE_CAPSULA };
+    teste.capsula = TestesAcerto_PrepararCapsula(inicio, fim, raio);
+    Caixa caixa = {
+        fminf(inicio.x, fim.x) - raio, fminf(inicio.y, fim.y) - raio,
+        fmaxf(inicio.x, fim.x) + raio, fmaxf(inicio.y, fim.y) + raio
+    };
+    return FiltrarCaixa(g, caixa, &teste, saida, capacidade);
+}
@@ -26,14 +26,14 @@ bool IniciarJogador(Jogador* j,
     j->vidaMaxima = vida;
     j->regeneracaoBase = 2.0f;
 
-    j->parado   = LoadTexture(caminhoParado);
-    j->andando1 = LoadTexture(caminhoAndando1);
-    j->andando2 = LoadTexture(caminhoAndando2);
-
-    if (j->parado.id == 0 || j->andando1.id == 0 || j->andando2.id == 0) {
-        if (j->parado.id)   UnloadTexture(j->parado);
-        if (j->andando1.id) UnloadTexture(j->andando1);
-        if (j->andando2.id) UnloadTexture(j->andando2);
+    j->parado   = Texturas_Carregar(caminhoParado);
+    j->andando1 = Texturas_Carregar(caminhoAndando1);
+    j->andando2 = Texturas_Carregar(caminhoAndando2);
+
+    if (j->parado == TEXTURA_NENHUMA || j->andando1 == TEXTURA_NENHUMA || j->andando2 == TEXTURA_NENHUMA) {
+        Texturas_Liberar(j->parado);
+        Texturas_Liberar(j->andando1);
+        Texturas_Liberar(j->andando2);
         memset(j, 0, sizeof(*j));
         return false;
     }
@@ -42,20 +42,25 @@ bool IniciarJogador(Jogador* j,
     j->acumulador    = 0.0f;
     j->alternarFrame = true;
     j->emMovimento   = false;
-    j->noAtual = NULL;
+    j->linhaAtual = -1;
+    j->colunaAtual = -1;
 
     return true;
 }
 
-void AtualizarJogador(Jogador* j, float dt)
+Vector2 LerDirecaoMovimentoTeclado(void)
 {
-    if (!j) return;
-
     Vector2 direcao = (Vector2){0.0f, 0.0f};
     if (IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D)) direcao.x += 1.0f;
     if (IsKeyDown(KEY_LEFT)  || IsKeyDown(KEY_A)) direcao.x -= 1.0f;
     if (IsKeyDown(KEY_UP)    || IsKeyDown(KEY_W)) direcao.y -= 1.0f;
     if (IsKeyDown(KEY_DOWN)  || IsKeyDown(KEY_S)) direcao.y += 1.0f;
+    return direcao;
+}
+
+void AtualizarJogador(Jogador* j, Vector2 direcao, float dt)
+{
+    if (!j) return;
 
     float magnitude = ComprimentoVetor(direcao.x, direcao.y);
     j->emMovimento = magnitude > 0.0001f;
@@ -83,17 +88,17 @@ void DesenharJogador(const Jogador* j)
 {
     if (!j) return;
 
-    Texture2D spriteAtual = j->parado;
+    IdTextura idSprite = j->parado;
     if (j->emMovimento)
-        spriteAtual = j->alternarFrame ? j->andando1 : j->andando2;
+        idSprite = j->alternarFrame ? j->andando1 : j->andando2;
+    SpriteTextura spriteAtual = Texturas_ObterSprite(idSprite);
 
     float escala = 1.0f;
 
-    DrawTextureEx(
+    Texturas_DesenharSprite(
         spriteAtual,
-        (Vector2){ j->posicao.x - (spriteAtual.width * escala) / 2,
-                   j->posicao.y - (spriteAtual.height * escala) / 2 },
-        0.0f,
+        (Vector2){ j->posicao.x - (spriteAtual.origem.width * escala) / 2,
+                   j->posicao.y - (spriteAtual.origem.height * escala) / 2 },
         escala,
         WHITE
     );
@@ -102,9 +107,9 @@ void DesenharJogador(const Jogador* j)
 void DescarregarJogador(Jogador* j)
 {
     if (!j) return;
-    if (j->parado.id)   UnloadTexture(j->parado);
-    if (j->andando1.id) UnloadTexture(j->andando1);
-    if (j->andando2.id) UnloadTexture(j->andando2);
+    Texturas_Liberar(j->parado);
+    Texturas_Liberar(j->andando1);
+    Texturas_Liberar(j->andando2);
     memset(j, 0, sizeof(*j));
 }
 
@@ -112,48 +117,36 @@ Vector2 TamanhoJogador(const Jogador* j)
 {
     if (!j) return (Vector2){0, 0};
 
-    Texture2D atual = j->parado;
+    IdTextura idAtual = j->parado;
     if (j->emMovimento)
-        atual = j->alternarFrame ? j->andando1 : j->andando2;
-
-    return (Vector2){ atual.width, atual.height };
+        idAtual = j->alternarFrame ? j->andando1 : j->andando2;
+    return Texturas_Tamanho(idAtual);
 }
 
-void AplicarColisaoPosicaoJogador(Jogador* j, Vector2 posAnterior,
-                                  Mapa **mapa, int linhas, int colunas,
-                                  int tileLargura, int tileAltura)
+void AplicarColisaoPosicaoJogador(Jogador* j, Vector2 posAnterior, const Mapa *mapa)
 {
     if (!j || !mapa) return;
 
-    int i, jx;
-    bool dentro = ConverterPosicaoParaIndice(j->posicao.x, j->posicao.y,
-                                             tileLargura, tileAltura,
-                                             linhas, colunas,
-                                             &i, &jx);
-    if (!dentro) {
-        j->posicao = posAnterior;
-        j->noAtual = NULL;
-        return;
-    }
-
-    if (TilePossuiColisao(mapa, linhas, colunas, i, jx)) {
+    AtualizarTileAtualJogador(j, mapa);
+    if (j->linhaAtual < 0 || TilePossuiColisao(mapa, j->linhaAtual, j->colunaAtual)) {
         j->posicao = posAnterior;
-        j->noAtual = &mapa[i][jx];
+        AtualizarTileAtualJogador(j, mapa);
     }
 }
 
-void AtualizarNoAtualJogador(Jogador* j, Mapa **mapa, int linhas, int colunas,
-                             int tileLargura, int tileAltura)
+void AtualizarTileAtualJogador(Jogador* j, const Mapa *mapa)
 {
     if (!j || !mapa) return;
 
     int i, jx;
     if (ConverterPosicaoParaIndice(j->posicao.x, j->posicao.y,
-                                   tileLargura, tileAltura,
-                                   linhas, colunas,
+                                   mapa->tileLargura, mapa->tileAltura,
+                                   mapa->linhas, mapa->colunas,
                                    &i, &jx)) {
-        j->noAtual = &mapa[i][jx];
+        j->linhaAtual = i;
+        j->colunaAtual = jx;
     } else {
-        j->noAtual = NULL;
+        j->linhaAtual = -1;
+        j->colunaAtual = -1;
     }
 }
@@ -2,12 +2,22 @@
 #include "ui_utils.h"
 #include "mapa.h"
 #include "monstro_dados.h"
+#include "perfil.h"
+#include "rascunho.h"
+#include "tarefas.h"
+#include "testes_acerto.h"
 #include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #define RAYGUN_PROJETIL_VELOCIDADE 650.0f
 #define INTERVALO_SPAWN_FIXO 0.9f
+#define TILES_POR_CELULA_GRADE 2
+#define JANELA_GRADE_TILES 256
+#define RAIO_MONSTRO_ACERTO 18.0f
+// Monstros por lote do passo paralelo; hordas menores rodam numa thread só
+#define LOTE_MONSTROS 256
 
 static float ComprimentoV2(Vector2 v);
 static Vector2 NormalizarV2(Vector2 v);
@@ -17,35 +27,85 @@ static void SolicitarRetornoMenu(EstadoJogo *estado)
 {
     if (!estado) return;
     estado->pausado = false;
-    estado->projetilRaygun.ativo = false;
+    Projeteis_Limpar(&estado->projeteis);
     estado->armaSecundaria.ativo = false;
     estado->armaSecundaria.dados = NULL;
     estado->cooldownArmaSecundaria = 0.0f;
     estado->solicitouRetornoMenu = true;
 }
 
-static bool EscudoProtegePosicao(const EstadoArmaSecundaria *estadoSec, Vector2 posicao, Vector2 posJogador)
+// Início (em tiles) de uma janela de `tamanho` tiles em volta de `centro`,
+// andando em passos de um quarto de janela para não mudar a cada passo
+static int InicioJanelaGrade(float centro, int tamanhoTile, int totalTiles, int tamanho)
+{
+    const int passo = JANELA_GRADE_TILES / 4;
+    int inicio = (int)floorf(centro / tamanhoTile) - tamanho / 2;
+    inicio = (int)floorf((float)inicio / passo) * passo;
+    if (inicio > totalTiles - tamanho) inicio = totalTiles - tamanho;
+    if (inicio < 0) inicio = 0;
+    return inicio;
+}
+
+// Em mapas grandes a grade cobre só uma janela em volta do jogador, onde os
+// monstros nascem; os que ficarem fora caem nas células da borda.
+static void ConfigurarGradeMonstros(EstadoJogo *estado, Vector2 centro, int linhasMapa, int colunasMapa,
+                                    int tileLargura, int tileAltura)
+{
+    GradeEspacial *grade = &estado->gradeMonstros;
+    bool novaGrade = (grade->inicioCelula == NULL);
+    int linhas = linhasMapa < JANELA_GRADE_TILES ? linhasMapa : JANELA_GRADE_TILES;
+    int colunas = colunasMapa < JANELA_GRADE_TILES ? colunasMapa : JANELA_GRADE_TILES;
+    float origemX = (float)(InicioJanelaGrade(centro.x, tileLargura, colunasMapa, colunas) * tileLargura);
+    float origemY = (float)(InicioJanelaGrade(centro.y, tileAltura, linhasMapa, linhas) * tileAltura);
+    bool moveu = (grade->origemX != origemX || grade->origemY != origemY);
+    if (!GradeEspacial_Configurar(grade, origemX, origemY,
+                                  (float)(colunas * tileLargura),
+                                  (float)(linhas * tileAltura),
+                                  (float)(TILES_POR_CELULA_GRADE * tileLargura))) {
+        return;
+    }
+    if (novaGrade || moveu) estado->gradeMonstrosDesatualizada = true;
+}
+
+// Reconstrói a grade só quando algum monstro se moveu ou nasceu desde a última consulta
+static void GarantirGradeMonstros(EstadoJogo *estado)
+{
+    if (!estado->gradeMonstrosDesatualizada) return;
+    GradeEspacial *grade = &estado->gradeMonstros;
+    const ConjuntoMonstros *monstros = &estado->monstros;
+    GradeEspacial_Limpar(grade);
+    for (int i = 0; i < monstros->quantidade; ++i) {
+        GradeEspacial_Inserir(grade, i, (Vector2){ monstros->posX[i], monstros->posY[i] });
+    }
+    GradeEspacial_Finalizar(grade);
+    estado->gradeMonstrosDesatualizada = false;
+}
+
+// Grade em dia e um vetor de rascunho para os índices de uma consulta; nenhuma
+// consulta devolve mais índices do que há monstros na grade. Quem pede devolve
+// o vetor com Rascunho_Voltar.
+static int *CandidatosRascunho(EstadoJogo *estado, int *capacidade)
+{
+    GarantirGradeMonstros(estado);
+    int *candidatos = RASCUNHO_VETOR(int, estado->gradeMonstros.quantidade);
+    *capacidade = candidatos ? estado->gradeMonstros.quantidade : 0;
+    return candidatos;
+}
+
+// Verdadeiro se o escudo cobre algum ponto do trajeto [inicio, fim]
+static bool EscudoProtegeTrajeto(const EstadoArmaSecundaria *estadoSec, Vector2 inicio, Vector2 fim,
+                                 Vector2 posJogador)
 {
     if (!estadoSec || !estadoSec->ativo || !estadoSec->dados) return false;
     if (estadoSec->dados->tipo != TIPO_ARMA_SECUNDARIA_DEFESA_TEMPORARIA) return false;
     float raio = (estadoSec->dados->raioOuAlcance > 0.0f) ? estadoSec->dados->raioOuAlcance : 90.0f;
     Vector2 centro = estadoSec->segueJogador ? posJogador : estadoSec->centro;
-    Vector2 delta = { posicao.x - centro.x, posicao.y - centro.y };
-    return ComprimentoV2(delta) <= raio;
+    return TestesAcerto_DistanciaSegmento2(inicio, fim, centro) <= raio * raio;
 }
 
-static bool PontoDentroConeSecundaria(Vector2 origem, Vector2 direcao, float alcance, float abertura, Vector2 ponto)
+static bool EscudoProtegePosicao(const EstadoArmaSecundaria *estadoSec, Vector2 posicao, Vector2 posJogador)
 {
-    Vector2 delta = { ponto.x - origem.x, ponto.y - origem.y };
-    float dist = ComprimentoV2(delta);
-    if (dist <= 0.0001f || dist > alcance) return false;
-    Vector2 dirNorm = NormalizarV2(direcao);
-    Vector2 pontoNorm = { delta.x / dist, delta.y / dist };
-    float dot = ProdutoEscalar(dirNorm, pontoNorm);
-    if (dot > 1.0f) dot = 1.0f;
-    if (dot < -1.0f) dot = -1.0f;
-    float angulo = acosf(dot) * RAD2DEG;
-    return angulo <= (abertura * 0.5f);
+    return EscudoProtegeTrajeto(estadoSec, posicao, posicao, posJogador);
 }
 
 static void AplicarEfeitosArmaSecundaria(EstadoJogo *estado, Jogador *jogador, float dt)
@@ -60,14 +120,18 @@ static void AplicarEfeitosArmaSecundaria(EstadoJogo *estado, Jogador *jogador, f
             float raio = (sec->dados->raioOuAlcance > 0.0f) ? sec->dados->raioOuAlcance : 150.0f;
             float danoTick = sec->dados->dano * dt;
             if (danoTick <= 0.0f) break;
-            for (int i = 0; i < MAX_MONSTROS; ++i) {
-                Monstro *monstro = &estado->monstros[i];
-                if (!monstro->ativo) continue;
-                Vector2 delta = { monstro->posicao.x - centro.x, monstro->posicao.y - centro.y };
-                if (ComprimentoV2(delta) <= raio) {
-                    monstro->vida -= danoTick;
-                }
+            size_t marca = Rascunho_Marca();
+            int capacidade;
+            int *candidatos = CandidatosRascunho(estado, &capacidade);
+            int quantidade = GradeEspacial_ConsultarCirculo(&estado->gradeMonstros, centro, raio,
+                                                            candidatos, capacidade);
+            ConjuntoMonstros *monstros = &estado->monstros;
+            for (int k = 0; k < quantidade; ++k) {
+                int i = candidatos[k];
+                if (monstros->vida[i] <= 0.0f) continue;
+                monstros->vida[i] -= danoTick;
             }
+            Rascunho_Voltar(marca);
         } break;
         case TIPO_ARMA_SECUNDARIA_CONE_EMPURRAO: {
             if (sec->impactoAplicado) break;
@@ -76,15 +140,21 @@ static void AplicarEfeitosArmaSecundaria(EstadoJogo *estado, Jogador *jogador, f
             float alcance = (sec->dados->raioOuAlcance > 0.0f) ? sec->dados->raioOuAlcance : 200.0f;
             float abertura = 80.0f;
             float empurrao = alcance * 0.4f;
-            for (int i = 0; i < MAX_MONSTROS; ++i) {
-                Monstro *monstro = &estado->monstros[i];
-                if (!monstro->ativo) continue;
-                if (PontoDentroConeSecundaria(centro, dir, alcance, abertura, monstro->posicao)) {
-                    monstro->vida -= sec->dados->dano;
-                    monstro->posicao.x += dir.x * empurrao;
-                    monstro->posicao.y += dir.y * empurrao;
-                }
+            size_t marca = Rascunho_Marca();
+            int capacidade;
+            int *candidatos = CandidatosRascunho(estado, &capacidade);
+            int quantidade = GradeEspacial_ConsultarCone(&estado->gradeMonstros, centro, dir,
+                                                         alcance, abertura, 0.0f, candidatos, capacidade);
+            ConjuntoMonstros *monstros = &estado->monstros;
+            for (int k = 0; k < quantidade; ++k) {
+                int i = candidatos[k];
+                if (monstros->vida[i] <= 0.0f) continue;
+                monstros->vida[i] -= sec->dados->dano;
+                monstros->posX[i] += dir.x * empurrao;
+                monstros->posY[i] += dir.y * empurrao;
+                estado->gradeMonstrosDesatualizada = true;
             }
+            Rascunho_Voltar(marca);
             sec->impactoAplicado = true;
         } break;
         default:
@@ -115,114 +185,76 @@ static float ProdutoEscalar(Vector2 a, Vector2 b)
     return a.x * b.x + a.y * b.y;
 }
 
-static float DistanciaPontoSegmento(Vector2 ponto, Vector2 inicio, Vector2 fim)
-{
-    Vector2 segmento = { fim.x - inicio.x, fim.y - inicio.y };
-    float comprimento2 = segmento.x * segmento.x + segmento.y * segmento.y;
-    if (comprimento2 <= 0.0001f) {
-        return ComprimentoV2((Vector2){ ponto.x - inicio.x, ponto.y - inicio.y });
-    }
-    float t = ProdutoEscalar((Vector2){ ponto.x - inicio.x, ponto.y - inicio.y }, segmento) / comprimento2;
-    if (t < 0.0f) t = 0.0f;
-    if (t > 1.0f) t = 1.0f;
-    Vector2 proj = { inicio.x + segmento.x * t, inicio.y + segmento.y * t };
-    return ComprimentoV2((Vector2){ ponto.x - proj.x, ponto.y - proj.y });
-}
-
 static void ResetarMonstros(EstadoJogo *estado)
 {
     if (!estado) return;
-    for (int i = 0; i < MAX_MONSTROS; ++i) {
-        if (estado->monstros[i].sprite1.id != 0 ||
-            estado->monstros[i].sprite2.id != 0 ||
-            estado->monstros[i].sprite3.id != 0) {
-            DescarregarMonstro(&estado->monstros[i]);
-        } else {
-            memset(&estado->monstros[i], 0, sizeof(Monstro));
-        }
-        estado->monstros[i].ativo = false;
-    }
-    for (int i = 0; i < MAX_OBJETOS_VOO; ++i) {
-        if (estado->objetosEmVoo[i].sprite.id != 0) {
-            UnloadTexture(estado->objetosEmVoo[i].sprite);
-        }
-    }
+    ConjuntoMonstros_Limpar(&estado->monstros);
     memset(estado->objetosEmVoo, 0, sizeof(estado->objetosEmVoo));
-    estado->monstrosAtivos = 0;
+    estado->gradeMonstrosDesatualizada = true;
     estado->tempoSpawnMonstro = 0.0f;
     estado->tempoTotalJogo = 0.0f;
     estado->intervaloSpawnMonstro = INTERVALO_SPAWN_FIXO;
 }
 
-static void DesativarMonstro(EstadoJogo *estado, Monstro *monstro, bool concederPontos)
+// As mortes são adiadas até aqui para que os índices da grade continuem válidos
+// durante as fases de dano; a remoção por troca com o último invalida a grade.
+static void RecolherMonstrosMortos(EstadoJogo *estado)
 {
-    if (!estado || !monstro || !monstro->ativo) return;
-    if (concederPontos && monstro->pontuacao > 0) {
-        estado->pontuacaoTotal += monstro->pontuacao;
-    }
-    DescarregarMonstro(monstro);
-    monstro->ativo = false;
-    if (estado->monstrosAtivos > 0) estado->monstrosAtivos--;
-}
-
-static bool PontoDentroDoCone(Vector2 ponto, float raioExtra, const EfeitoVisualArmaPrincipal *efeito)
-{
-    Vector2 delta = { ponto.x - efeito->origem.x, ponto.y - efeito->origem.y };
-    float distancia = ComprimentoV2(delta);
-    float alcance = (efeito->alcance > 0.0f) ? efeito->alcance : 1.0f;
-    if (distancia <= 0.0001f) return true;
-    if (distancia - raioExtra > alcance) return false;
-    Vector2 direcaoPonto = (Vector2){ delta.x / distancia, delta.y / distancia };
-    Vector2 direcaoCone = NormalizarV2(efeito->direcao);
-    float dot = ProdutoEscalar(direcaoPonto, direcaoCone);
-    if (dot > 1.0f) dot = 1.0f;
-    if (dot < -1.0f) dot = -1.0f;
-    float angulo = acosf(dot) * RAD2DEG;
-    float meiaAbertura = efeito->coneAberturaGraus * 0.5f;
-    if (raioExtra > 0.0f && distancia > 0.0001f) {
-        float ajuste = asinf(fminf(raioExtra / distancia, 1.0f)) * RAD2DEG;
-        meiaAbertura += ajuste;
+    if (!estado) return;
+    ConjuntoMonstros *monstros = &estado->monstros;
+    for (int i = monstros->quantidade - 1; i >= 0; --i) {
+        if (monstros->vida[i] > 0.0f) continue;
+        int pontos = gMonstrosInfo[monstros->tipo[i]].pontuacao;
+        if (pontos > 0) estado->pontuacaoTotal += pontos;
+        RemoverMonstro(monstros, i);
+        estado->gradeMonstrosDesatualizada = true;
     }
-    return angulo <= meiaAbertura;
 }
 
-static bool PontoDentroDoEfeito(const Monstro *monstro, const EfeitoVisualArmaPrincipal *efeito)
+// Monstros cujo círculo de acerto encosta na área do efeito, já com o teste
+// exato; os índices vão para `saida`, com espaço para `capacidade`
+static int ConsultarAcertosEfeito(EstadoJogo *estado, const EfeitoVisualArmaPrincipal *efeito,
+                                  int *saida, int capacidade)
 {
-    if (!monstro || !efeito) return false;
-    const float raioMonstro = 18.0f;
-    Vector2 pos = monstro->posicao;
-
+    const GradeEspacial *grade = &estado->gradeMonstros;
     switch (efeito->formato) {
-        case TIPO_AREA_CONE:
-            return PontoDentroDoCone(pos, raioMonstro, efeito);
+        case TIPO_AREA_CONE: {
+            float alcance = (efeito->alcance > 0.0f) ? efeito->alcance : 1.0f;
+            return GradeEspacial_ConsultarCone(grade, efeito->origem, efeito->direcao, alcance,
+                                               efeito->coneAberturaGraus, RAIO_MONSTRO_ACERTO,
+                                               saida, capacidade);
+        }
         case TIPO_AREA_PONTO: {
             float raio = (efeito->raio > 0.0f) ? efeito->raio : 32.0f;
-            return ComprimentoV2((Vector2){ pos.x - efeito->destino.x, pos.y - efeito->destino.y }) <= (raio + raioMonstro);
+            return GradeEspacial_ConsultarCirculo(grade, efeito->destino, raio + RAIO_MONSTRO_ACERTO,
+                                                  saida, capacidade);
         }
         case TIPO_AREA_LINHA:
         case TIPO_AREA_NENHUMA: {
             float largura = efeito->larguraLinha > 0.0f ? efeito->larguraLinha : 18.0f;
-            float distancia = DistanciaPontoSegmento(pos, efeito->origem, efeito->destino);
-            return distancia <= (largura * 0.5f + raioMonstro);
+            return GradeEspacial_ConsultarCapsula(grade, efeito->origem, efeito->destino,
+                                                  largura * 0.5f + RAIO_MONSTRO_ACERTO,
+                                                  saida, capacidade);
         }
         default:
-            return false;
+            return 0;
     }
 }
 
 static void AplicarDanoMonstrosEfeito(EstadoJogo *estado, const EfeitoVisualArmaPrincipal *efeito, float dano)
 {
     if (!estado || !efeito || dano <= 0.0f) return;
-    for (int i = 0; i < MAX_MONSTROS; ++i) {
-        Monstro *monstro = &estado->monstros[i];
-        if (!monstro->ativo) continue;
-        if (PontoDentroDoEfeito(monstro, efeito)) {
-            monstro->vida -= dano;
-            if (monstro->vida <= 0.0f) {
-                DesativarMonstro(estado, monstro, true);
-            }
-        }
+    size_t marca = Rascunho_Marca();
+    int capacidade;
+    int *candidatos = CandidatosRascunho(estado, &capacidade);
+    int quantidade = ConsultarAcertosEfeito(estado, efeito, candidatos, capacidade);
+    ConjuntoMonstros *monstros = &estado->monstros;
+    for (int k = 0; k < quantidade; ++k) {
+        int i = candidatos[k];
+        if (monstros->vida[i] <= 0.0f) continue;
+        monstros->vida[i] -= dano;
     }
+    Rascunho_Voltar(marca);
 }
 
 static void RegistrarObjetoLancado(EstadoJogo *estado, const ObjetoLancavel *origem)
@@ -230,19 +262,42 @@ static void RegistrarObjetoLancado(EstadoJogo *estado, const ObjetoLancavel *ori
     if (!estado || !origem) return;
     for (int k = 0; k < MAX_OBJETOS_VOO; ++k) {
         if (!estado->objetosEmVoo[k].ativo) {
-            if (estado->objetosEmVoo[k].sprite.id != 0) {
-                UnloadTexture(estado->objetosEmVoo[k].sprite);
-            }
             estado->objetosEmVoo[k] = *origem;
             estado->objetosEmVoo[k].tempoVida = 0.0f;
-            if (estado->objetosEmVoo[k].caminhoSprite[0] != '\0') {
-                estado->objetosEmVoo[k].sprite = LoadTexture(estado->objetosEmVoo[k].caminhoSprite);
-            }
             return;
         }
     }
 }
 
+// Dados de um passo dos monstros compartilhados pelos lotes paralelos
+typedef struct {
+    ConjuntoMonstros *monstros;
+    const Jogador *jogador;
+    const CampoFluxo *campo;
+    const GradeEspacial *grade;
+    Vector2 posicaoAnteriorJogador;
+    float raioSeparacao;
+    float dt;
+} PassoMonstros;
+
+// Primeira fase: lê as posições de todos, escreve só temporizadores e velocidades do lote
+static void CalcularLoteMonstros(void *contexto, int inicio, int fim)
+{
+    PassoMonstros *passo = (PassoMonstros *)contexto;
+    AtualizarTemporizadoresMonstros(passo->monstros, inicio, fim, passo->dt);
+    IACalcularVelocidadesMonstros(passo->monstros, inicio, fim, passo->jogador->posicao,
+                                  passo->campo, passo->grade, passo->raioSeparacao);
+}
+
+// Segunda fase: integra as posições do lote e gera as intenções de ataque
+static void MoverLoteMonstros(void *contexto, int inicio, int fim)
+{
+    PassoMonstros *passo = (PassoMonstros *)contexto;
+    IAIntegrarMonstros(passo->monstros, inicio, fim, passo->dt);
+    GerarIntencoesMonstros(passo->monstros, inicio, fim, passo->dt, passo->jogador,
+                           passo->posicaoAnteriorJogador);
+}
+
 static void AtualizarObjetosLancados(EstadoJogo *estado, Jogador *jogador, float dt)
 {
     if (!estado || !jogador) return;
@@ -250,11 +305,12 @@ static void AtualizarObjetosLancados(EstadoJogo *estado, Jogador *jogador, float
         ObjetoLancavel *obj = &estado->objetosEmVoo[i];
         if (!obj->ativo) continue;
         AtualizarObjeto(obj, dt);
-        if (EscudoProtegePosicao(&estado->armaSecundaria, obj->posicao, jogador->posicao)) {
+        if (EscudoProtegeTrajeto(&estado->armaSecundaria, obj->posicaoAnterior, obj->posicao,
+                                 jogador->posicao)) {
             obj->ativo = false;
             continue;
         }
-        if (VerificarColisaoObjetoJogador(obj, jogador)) {
+        if (VerificarColisaoObjetoJogador(obj, jogador, estado->posicaoAnteriorJogador)) {
             if (!EscudoProtegePosicao(&estado->armaSecundaria, jogador->posicao, jogador->posicao)) {
                 jogador->vida -= obj->dano;
                 if (jogador->vida < 0.0f) jogador->vida = 0.0f;
@@ -268,31 +324,95 @@ static void AtualizarObjetosLancados(EstadoJogo *estado, Jogador *jogador, float
     }
 }
 
-static void DesenharObjetosLancados(const EstadoJogo *estado)
+static Vector2 InterpolarV2(Vector2 anterior, Vector2 atual, float alfa)
+{
+    return (Vector2){ anterior.x + (atual.x - anterior.x) * alfa,
+                      anterior.y + (atual.y - anterior.y) * alfa };
+}
+
+// Guarda as posições do início do passo; JogoDesenhar interpola entre elas e as
+// do fim do passo conforme a fração de passo acumulada pelo laço da aplicação.
+static void ArmazenarPosicoesAnteriores(EstadoJogo *estado, const Jogador *jogador)
+{
+    estado->posicaoAnteriorJogador = jogador->posicao;
+    Projeteis_ArmazenarPosicoesAnteriores(&estado->projeteis);
+    ArmazenarPosicoesAnterioresMonstros(&estado->monstros);
+    for (int i = 0; i < MAX_OBJETOS_VOO; ++i) {
+        estado->objetosEmVoo[i].posicaoAnterior = estado->objetosEmVoo[i].posicao;
+    }
+}
+
+static void DesenharObjetosLancados(const EstadoJogo *estado, float alfa)
 {
     if (!estado) return;
     for (int i = 0; i < MAX_OBJETOS_VOO; ++i) {
         if (estado->objetosEmVoo[i].ativo) {
-            DesenharObjeto(&estado->objetosEmVoo[i]);
+            ObjetoLancavel objeto = estado->objetosEmVoo[i];
+            objeto.posicao = InterpolarV2(objeto.posicaoAnterior, objeto.posicao, alfa);
+            DesenharObjeto(&objeto);
         }
     }
 }
 
-void JogoInicializar(EstadoJogo *estado, float regeneracaoBase)
+// Tudo que dura a partida inteira e cresceria sob demanda sai de uma arena só,
+// dimensionada pelo pior caso (limite de monstros, janelas da grade e do
+// campo). Recortada de novo a cada JogoReiniciar, nenhum passo da partida
+// chama malloc/free por conta desses dados.
+#define CELULAS_GRADE_MAX ((JANELA_GRADE_TILES / TILES_POR_CELULA_GRADE + 1) * \
+                           (JANELA_GRADE_TILES / TILES_POR_CELULA_GRADE + 1))
+#define TILES_CAMPO_MAX (CAMPO_FLUXO_JANELA * CAMPO_FLUXO_JANELA)
+
+static size_t TamanhoMemoriaPartida(int limiteMonstros)
+{
+    return ConjuntoMonstros_TamanhoArena(limiteMonstros) +
+           GradeEspacial_TamanhoArena(CELULAS_GRADE_MAX, limiteMonstros) +
+           CampoFluxo_TamanhoArena(TILES_CAMPO_MAX);
+}
+
+static bool ReservarMemoriaPartida(EstadoJogo *estado)
+{
+    Arena *arena = &estado->memoriaPartida;
+    Arena_Resetar(arena);
+    bool ok = ConjuntoMonstros_InicializarArena(&estado->monstros, estado->limiteMonstros, arena);
+    ok = GradeEspacial_ReservarArena(&estado->gradeMonstros, CELULAS_GRADE_MAX,
+                                     estado->limiteMonstros, arena) && ok;
+    ok = CampoFluxo_ReservarArena(&estado->campoFluxo, TILES_CAMPO_MAX, arena) && ok;
+    return ok;
+}
+
+void JogoInicializar(EstadoJogo *estado, float regeneracaoBase, int limiteMonstros)
 {
     if (!estado) return;
+    if (limiteMonstros <= 0) limiteMonstros = LIMITE_MONSTROS_PADRAO;
+    if (limiteMonstros > LIMITE_MONSTROS_MAXIMO) {
+        printf("Aviso: limite de %d monstros acima do maximo, usando %d\n", limiteMonstros, LIMITE_MONSTROS_MAXIMO);
+        limiteMonstros = LIMITE_MONSTROS_MAXIMO;
+    }
     memset(estado, 0, sizeof(*estado));
     estado->regeneracaoAtual = regeneracaoBase;
     estado->solicitouRetornoMenu = false;
     estado->pontuacaoTotal = 0;
     estado->jogadorMorto = false;
+    estado->limiteMonstros = limiteMonstros;
+    estado->raioSeparacao = RAIO_SEPARACAO_PADRAO;
+    if (!Arena_Inicializar(&estado->memoriaPartida, TamanhoMemoriaPartida(estado->limiteMonstros)) ||
+        !ReservarMemoriaPartida(estado)) {
+        // Sem a arena cada estrutura volta a crescer pelo heap
+        printf("Aviso: memoria da partida fora da arena\n");
+        Arena_Liberar(&estado->memoriaPartida);
+        ConjuntoMonstros_Inicializar(&estado->monstros, estado->limiteMonstros);
+        memset(&estado->gradeMonstros, 0, sizeof(estado->gradeMonstros));
+        memset(&estado->campoFluxo, 0, sizeof(estado->campoFluxo));
+    }
+    CampoFluxo_Invalidar(&estado->campoFluxo);
     ResetarMonstros(estado);
 }
 
-void JogoReiniciar(EstadoJogo *estado, Jogador *jogador, Camera2D *camera, Vector2 posInicial)
+void JogoReiniciar(EstadoJogo *estado, Jogador *jogador, Camera2D *camera, Vector2 posInicial,
+                   uint64_t semente)
 {
     if (!estado || !jogador || !camera) return;
-    estado->projetilRaygun = (ProjetilRaygun){0};
+    Projeteis_Limpar(&estado->projeteis);
     estado->armaSecundaria = (EstadoArmaSecundaria){0};
     estado->cooldownArmaSecundaria = 0.0f;
     estado->pausado = false;
@@ -303,41 +423,59 @@ void JogoReiniciar(EstadoJogo *estado, Jogador *jogador, Camera2D *camera, Vecto
     estado->tempoSpawnMonstro = 0.0f;
     estado->tempoTotalJogo = 0.0f;
     estado->intervaloSpawnMonstro = INTERVALO_SPAWN_FIXO;
+    estado->semente = semente;
+    Aleatorio_Semear(&estado->aleatorio, semente);
+    if (estado->memoriaPartida.base) ReservarMemoriaPartida(estado);
     ResetarMonstros(estado);
+    CampoFluxo_Invalidar(&estado->campoFluxo);
     jogador->posicao = posInicial;
+    estado->posicaoAnteriorJogador = posInicial;
     camera->target = jogador->posicao;
 }
 
-static void AtualizarProjetilRaygun(EstadoJogo *estado, float dt)
-{
-    if (!estado || !estado->projetilRaygun.ativo) return;
-    estado->projetilRaygun.posicao.x += estado->projetilRaygun.velocidade.x * dt;
-    estado->projetilRaygun.posicao.y += estado->projetilRaygun.velocidade.y * dt;
-    const ArmaPrincipal *armaProj = estado->projetilRaygun.arma;
-    float raioAcerto = (armaProj && armaProj->raioProjetilColisao > 0.0f)
-                       ? armaProj->raioProjetilColisao
-                       : 18.0f;
-    for (int i = 0; i < MAX_MONSTROS; ++i) {
-        Monstro *monstro = &estado->monstros[i];
-        if (!monstro->ativo) continue;
-        float distancia = ComprimentoV2((Vector2){ monstro->posicao.x - estado->projetilRaygun.posicao.x,
-                                                   monstro->posicao.y - estado->projetilRaygun.posicao.y });
-        if (distancia <= raioAcerto) {
-            float dano = armaProj ? armaProj->danoBase : 0.0f;
-            monstro->vida -= dano;
-            if (monstro->vida <= 0.0f) {
-                DesativarMonstro(estado, monstro, true);
+// Move os projéteis do jogador; cada um acerta no máximo um monstro e some
+static void AtualizarProjeteis(EstadoJogo *estado, float dt)
+{
+    if (!estado || estado->projeteis.quantidade == 0) return;
+    ConjuntoProjeteis *projeteis = &estado->projeteis;
+    Projeteis_Mover(projeteis, dt);
+    size_t marca = Rascunho_Marca();
+    int capacidade;
+    int *candidatos = CandidatosRascunho(estado, &capacidade);
+    for (int i = 0; i < projeteis->limite; ++i) {
+        if (!projeteis->ativo[i]) continue;
+        const ArmaPrincipal *armaProj = projeteis->arma[i];
+        float raioAcerto = (armaProj && armaProj->raioProjetilColisao > 0.0f)
+                           ? armaProj->raioProjetilColisao
+                           : 18.0f;
+        // Trajeto inteiro do passo: a 650 px/s um passo longo pularia monstros
+        Vector2 inicio = { projeteis->posXAnterior[i], projeteis->posYAnterior[i] };
+        Vector2 fim = { projeteis->posX[i], projeteis->posY[i] };
+        int quantidade = GradeEspacial_ConsultarCapsula(&estado->gradeMonstros, inicio, fim, raioAcerto,
+                                                        candidatos, capacidade);
+        // O primeiro monstro ao longo do trajeto leva o tiro; empate fica com o menor índice
+        Vector2 trajeto = { fim.x - inicio.x, fim.y - inicio.y };
+        int alvo = -1;
+        float menorAvanco = 0.0f;
+        for (int k = 0; k < quantidade; ++k) {
+            int indice = candidatos[k];
+            if (estado->monstros.vida[indice] <= 0.0f) continue;
+            Vector2 delta = { estado->monstros.posX[indice] - inicio.x, estado->monstros.posY[indice] - inicio.y };
+            float avanco = ProdutoEscalar(delta, trajeto);
+            if (alvo < 0 || avanco < menorAvanco || (avanco == menorAvanco && indice < alvo)) {
+                alvo = indice;
+                menorAvanco = avanco;
             }
-            estado->projetilRaygun.ativo = false;
-            estado->projetilRaygun.arma = NULL;
-            return;
+        }
+        if (alvo >= 0) {
+            float dano = armaProj ? armaProj->danoBase : 0.0f;
+            estado->monstros.vida[alvo] -= dano;
+            Projeteis_Remover(projeteis, i);
+        } else if (projeteis->tempoRestante[i] <= 0.0f) {
+            Projeteis_Remover(projeteis, i);
         }
     }
-    estado->projetilRaygun.tempoRestante -= dt;
-    if (estado->projetilRaygun.tempoRestante <= 0.0f) {
-        estado->projetilRaygun.ativo = false;
-        estado->projetilRaygun.arma = NULL;
-    }
+    Rascunho_Voltar(marca);
 }
 
 static bool TentarSpawnMonstro(EstadoJogo *estado,
@@ -348,54 +486,108 @@ static bool TentarSpawnMonstro(EstadoJogo *estado,
                                int tileAltura)
 {
     if (!estado || !jogador) return false;
-    for (int i = 0; i < MAX_MONSTROS; ++i) {
-        Monstro *monstro = &estado->monstros[i];
-        if (monstro->ativo) continue;
-
-        Vector2 spawn = GerarMonstros(jogador, linhasMapa, colunasMapa, tileLargura, tileAltura);
-        TipoMonstro tipo = (TipoMonstro)GetRandomValue(0, MONSTRO_TIPOS_COUNT - 1);
-        const MonstroInfo *info = ObterInfoMonstro(tipo);
-        if (!info) continue;
-        memset(monstro, 0, sizeof(Monstro));
-        if (IniciarMonstro(monstro, spawn, info)) {
-            CarregarAssetsMonstro(monstro);
-            monstro->ativo = true;
-            estado->monstrosAtivos++;
-            return true;
+    if (estado->monstros.quantidade >= estado->limiteMonstros) return false;
+
+    Vector2 spawn = GerarMonstros(jogador, linhasMapa, colunasMapa, tileLargura, tileAltura,
+                                  &estado->aleatorio);
+    TipoMonstro tipo = (TipoMonstro)Aleatorio_Intervalo(&estado->aleatorio, 0, MONSTRO_TIPOS_COUNT - 1);
+    const MonstroInfo *info = ObterInfoMonstro(tipo);
+    if (!info) return false;
+    if (AdicionarMonstro(&estado->monstros, spawn, info) < 0) return false;
+    estado->gradeMonstrosDesatualizada = true;
+    PERFIL_EVENTO("Spawn monstro", estado->monstros.quantidade);
+    return true;
+}
+
+void JogoPassoMonstros(EstadoJogo *estado, Jogador *jogador, const Mapa *mapa, float dt)
+{
+    if (!estado || !jogador) return;
+    // Janela da grade em volta do jogador já movido neste tick; fora de
+    // JogoAtualizar (benchmarks) é o que posiciona a grade no mapa
+    if (mapa) {
+        ConfigurarGradeMonstros(estado, jogador->posicao, mapa->linhas, mapa->colunas,
+                                mapa->tileLargura, mapa->tileAltura);
+    }
+
+    ConjuntoMonstros *monstros = &estado->monstros;
+    for (int i = 0; i < monstros->quantidade; ++i) {
+        monstros->fatorVelocidade[i] = 1.0f;
+    }
+    if (estado->armaSecundaria.ativo &&
+        estado->armaSecundaria.dados &&
+        estado->armaSecundaria.dados->tipo == TIPO_ARMA_SECUNDARIA_ZONA_LENTIDAO) {
+        Vector2 centroZona = estado->armaSecundaria.segueJogador ? jogador->posicao : estado->armaSecundaria.centro;
+        float raioZona = (estado->armaSecundaria.dados->raioOuAlcance > 0.0f) ? estado->armaSecundaria.dados->raioOuAlcance : 160.0f;
+        size_t marca = Rascunho_Marca();
+        int capacidade;
+        int *candidatos = CandidatosRascunho(estado, &capacidade);
+        int quantidade = GradeEspacial_ConsultarCirculo(&estado->gradeMonstros, centroZona, raioZona,
+                                                        candidatos, capacidade);
+        for (int k = 0; k < quantidade; ++k) {
+            monstros->fatorVelocidade[candidatos[k]] = 0.4f;
+        }
+        Rascunho_Voltar(marca);
+    }
+
+    CampoFluxo_Atualizar(&estado->campoFluxo, mapa, jogador->linhaAtual, jogador->colunaAtual);
+    GarantirGradeMonstros(estado);
+    PassoMonstros passo = {
+        monstros, jogador, &estado->campoFluxo, &estado->gradeMonstros,
+        estado->posicaoAnteriorJogador, estado->raioSeparacao, dt
+    };
+    Tarefas_ParaleloPara(monstros->quantidade, LOTE_MONSTROS, CalcularLoteMonstros, &passo);
+    Tarefas_ParaleloPara(monstros->quantidade, LOTE_MONSTROS, MoverLoteMonstros, &passo);
+    if (monstros->quantidade > 0) estado->gradeMonstrosDesatualizada = true;
+
+    // Efeitos sobre o jogador e os objetos em voo, em ordem de índice
+    bool jogadorProtegido = EscudoProtegePosicao(&estado->armaSecundaria, jogador->posicao, jogador->posicao);
+    for (int i = 0; i < monstros->quantidade; ++i) {
+        if (monstros->intencao[i] & INTENCAO_ARREMESSO) {
+            ObjetoLancavel objeto;
+            PrepararObjetoMonstro(monstros, i, jogador->posicao, &objeto);
+            RegistrarObjetoLancado(estado, &objeto);
+        }
+
+        if ((monstros->intencao[i] & INTENCAO_CONTATO) && !jogadorProtegido) {
+            const MonstroInfo *info = &gMonstrosInfo[monstros->tipo[i]];
+            jogador->vida -= info->danoContato;
+            if (jogador->vida < 0.0f) jogador->vida = 0.0f;
+            monstros->acumuladorAtaque[i] = info->cooldownAtaque;
         }
-        break;
     }
-    return false;
 }
 
 void JogoAtualizar(EstadoJogo *estado,
                    Jogador *jogador,
                    Camera2D *camera,
-                   Mapa **mapa,
+                   Mapa *mapa,
                    int linhasMapa,
                    int colunasMapa,
                    int tileLargura,
                    int tileAltura,
                    float dt,
-                   Vector2 mouseNoMundo,
-                   bool mouseClickEsq,
-                   bool mouseClickDir,
-                   bool escapePress,
+                   const EntradaJogo *entrada,
                    const Armadura *armaduraAtual,
                    const Capacete *capaceteAtual,
                    ArmaPrincipal *armaPrincipalAtual,
                    const ArmaSecundaria *armaSecundariaAtual)
 {
-    if (!estado || !jogador || !camera) return;
+    if (!estado || !jogador || !camera || !entrada) return;
     (void)armaduraAtual;
     (void)capaceteAtual;
+    Vector2 mouseNoMundo = entrada->mouseNoMundo;
+
+    ArmazenarPosicoesAnteriores(estado, jogador);
+
+    ConfigurarGradeMonstros(estado, jogador->posicao, linhasMapa, colunasMapa, tileLargura, tileAltura);
 
     if (estado->jogadorMorto) {
-        AtualizarProjetilRaygun(estado, dt);
+        AtualizarProjeteis(estado, dt);
+        RecolherMonstrosMortos(estado);
         return;
     }
 
-    if (escapePress) estado->pausado = !estado->pausado;
+    if (entrada->pausar) estado->pausado = !estado->pausado;
 
     if (estado->cooldownArmaSecundaria > 0.0f) {
         estado->cooldownArmaSecundaria -= dt;
@@ -421,12 +613,14 @@ void JogoAtualizar(EstadoJogo *estado,
         estado->intervaloSpawnMonstro = CalcularIntervaloSpawnDinamico(estado->tempoTotalJogo);
 
         Vector2 posAnterior = jogador->posicao;
-        AtualizarJogador(jogador, dt);
-        AtualizarNoAtualJogador(jogador, mapa, linhasMapa, colunasMapa, tileLargura, tileAltura);
+        AtualizarJogador(jogador, entrada->direcaoMovimento, dt);
+        AtualizarRegioesMapa(mapa, jogador->posicao);
+        AtualizarTileAtualJogador(jogador, mapa);
 
-        if (jogador->noAtual && jogador->noAtual->colisao) {
+        if (jogador->linhaAtual >= 0 &&
+            TilePossuiColisao(mapa, jogador->linhaAtual, jogador->colunaAtual)) {
             jogador->posicao = posAnterior;
-            AtualizarNoAtualJogador(jogador, mapa, linhasMapa, colunasMapa, tileLargura, tileAltura);
+            AtualizarTileAtualJogador(jogador, mapa);
         }
 
         float maxX = colunasMapa * (float)tileLargura - 1.0f;
@@ -438,7 +632,7 @@ void JogoAtualizar(EstadoJogo *estado,
 
         camera->target = jogador->posicao;
 
-        if (armaPrincipalAtual && mouseClickEsq) {
+        if (armaPrincipalAtual && entrada->cliqueEsq) {
             bool ehRaygun = armaPrincipalAtual && (strcmp(armaPrincipalAtual->nome, "RayGun") == 0);
             if (ehRaygun) {
                 if (PodeAtacarArmaPrincipal(armaPrincipalAtual)) {
@@ -454,20 +648,15 @@ void JogoAtualizar(EstadoJogo *estado,
                     };
 
                     armaPrincipalAtual->tempoRecargaRestante = armaPrincipalAtual->tempoRecarga;
-                    estado->projetilRaygun.ativo = true;
-                    estado->projetilRaygun.arma = armaPrincipalAtual;
-                    estado->projetilRaygun.origem = jogador->posicao;
-                    estado->projetilRaygun.posicao = jogador->posicao;
-                    estado->projetilRaygun.destino = destino;
-                    estado->projetilRaygun.direcao = direcao;
-                    estado->projetilRaygun.velocidade = (Vector2){
+                    Vector2 velocidade = {
                         direcao.x * RAYGUN_PROJETIL_VELOCIDADE,
                         direcao.y * RAYGUN_PROJETIL_VELOCIDADE
                     };
                     float distProj = ComprimentoV2((Vector2){ destino.x - jogador->posicao.x, destino.y - jogador->posicao.y });
                     float tempoProj = distProj / RAYGUN_PROJETIL_VELOCIDADE;
                     if (tempoProj < 0.08f) tempoProj = 0.08f;
-                    estado->projetilRaygun.tempoRestante = tempoProj;
+                    Projeteis_Disparar(&estado->projeteis, armaPrincipalAtual, jogador->posicao,
+                                       velocidade, tempoProj);
                 }
             } else {
                 if (PodeAtacarArmaPrincipal(armaPrincipalAtual)) {
@@ -484,63 +673,35 @@ void JogoAtualizar(EstadoJogo *estado,
             }
         }
 
-        if (estado->projetilRaygun.ativo) {
-            AtualizarProjetilRaygun(estado, dt);
-        }
+        AtualizarProjeteis(estado, dt);
+        RecolherMonstrosMortos(estado);
 
         if (estado->regeneracaoAtual > 0.0f && jogador->vida < jogador->vidaMaxima) {
             jogador->vida += estado->regeneracaoAtual * dt;
             if (jogador->vida > jogador->vidaMaxima) jogador->vida = jogador->vidaMaxima;
         }
 
+        PERFIL_INICIO(PERFIL_MONSTROS);
         estado->tempoSpawnMonstro += dt;
         if (estado->tempoSpawnMonstro >= estado->intervaloSpawnMonstro &&
-            estado->monstrosAtivos < MAX_MONSTROS) {
+            estado->monstros.quantidade < estado->limiteMonstros) {
             estado->tempoSpawnMonstro = 0.0f;
             TentarSpawnMonstro(estado, jogador, linhasMapa, colunasMapa, tileLargura, tileAltura);
         }
 
-        for (int i = 0; i < MAX_MONSTROS; ++i) {
-            Monstro *monstro = &estado->monstros[i];
-            if (!monstro->ativo) continue;
-            AtualizarMonstro(monstro, dt);
-            float velocidadeOriginal = monstro->velocidade;
-            if (estado->armaSecundaria.ativo &&
-                estado->armaSecundaria.dados &&
-                estado->armaSecundaria.dados->tipo == TIPO_ARMA_SECUNDARIA_ZONA_LENTIDAO) {
-                Vector2 centroZona = estado->armaSecundaria.segueJogador ? jogador->posicao : estado->armaSecundaria.centro;
-                float raioZona = (estado->armaSecundaria.dados->raioOuAlcance > 0.0f) ? estado->armaSecundaria.dados->raioOuAlcance : 160.0f;
-                Vector2 deltaZona = { monstro->posicao.x - centroZona.x, monstro->posicao.y - centroZona.y };
-                if (ComprimentoV2(deltaZona) <= raioZona) {
-                    monstro->velocidade = velocidadeOriginal * 0.4f;
-                }
-            }
-            IAAtualizarMonstro(monstro, jogador, dt);
-            monstro->velocidade = velocidadeOriginal;
+        JogoPassoMonstros(estado, jogador, mapa, dt);
 
-            if (monstro->objeto && TentarLancarObjeto(monstro, dt, jogador->posicao)) {
-                RegistrarObjetoLancado(estado, monstro->objeto);
-                monstro->objeto->ativo = false;
-            }
-
-            if (VerificarColisaoMonstroJogador(monstro, jogador)) {
-                if (!EscudoProtegePosicao(&estado->armaSecundaria, jogador->posicao, jogador->posicao) &&
-                    monstro->acumuladorAtaque <= 0.0f) {
-                    jogador->vida -= monstro->danoContato;
-                    if (jogador->vida < 0.0f) jogador->vida = 0.0f;
-                    monstro->acumuladorAtaque = monstro->cooldownAtaque;
-                }
-            }
-
-            if (monstro->vida <= 0.0f) {
-                DesativarMonstro(estado, monstro, true);
-            }
-        }
+        PERFIL_FIM(PERFIL_MONSTROS);
 
+        PERFIL_INICIO(PERFIL_OBJETOS_LANCADOS);
         AtualizarObjetosLancados(estado, jogador, dt);
+        PERFIL_FIM(PERFIL_OBJETOS_LANCADOS);
+        PERFIL_INICIO(PERFIL_ARMA_SECUNDARIA);
         AplicarEfeitosArmaSecundaria(estado, jogador, dt);
+        PERFIL_FIM(PERFIL_ARMA_SECUNDARIA);
+        RecolherMonstrosMortos(estado);
 
-        if (armaSecundariaAtual && mouseClickDir) {
+        if (armaSecundariaAtual && entrada->cliqueDir) {
             if (!(estado->armaSecundaria.ativo || estado->cooldownArmaSecundaria > 0.0f)) {
                 estado->cooldownArmaSecundaria = armaSecundariaAtual->tempoRecarga;
                 estado->armaSecundaria.ativo = true;
@@ -563,7 +724,8 @@ void JogoAtualizar(EstadoJogo *estado,
             }
         }
     } else {
-        AtualizarProjetilRaygun(estado, dt);
+        AtualizarProjeteis(estado, dt);
+        RecolherMonstrosMortos(estado);
     }
 
     if (jogador->vida <= 0.0f && !estado->jogadorMorto) {
@@ -577,17 +739,38 @@ void JogoAtualizar(EstadoJogo *estado,
     }
 }
 
+// Folga em volta da tela para sprites e barras de vida que cruzam a borda
+#define MARGEM_DESENHO_MONSTROS 96.0f
+
+// Índices, em ordem, dos monstros cuja posição interpolada cai na área visível
+// da câmera; `saida` tem espaço para todos os monstros
+static int SelecionarMonstrosVisiveis(const ConjuntoMonstros *monstros, const Camera2D *camera,
+                                      int largura, int altura, float alfa, int *saida)
+{
+    Vector2 topoEsquerdo = GetScreenToWorld2D((Vector2){0, 0}, *camera);
+    Vector2 fundoDireito = GetScreenToWorld2D((Vector2){(float)largura, (float)altura}, *camera);
+    float minX = topoEsquerdo.x - MARGEM_DESENHO_MONSTROS;
+    float minY = topoEsquerdo.y - MARGEM_DESENHO_MONSTROS;
+    float maxX = fundoDireito.x + MARGEM_DESENHO_MONSTROS;
+    float maxY = fundoDireito.y + MARGEM_DESENHO_MONSTROS;
+    int quantidade = 0;
+    for (int i = 0; i < monstros->quantidade; ++i) {
+        float x = monstros->posXAnterior[i] + (monstros->posX[i] - monstros->posXAnterior[i]) * alfa;
+        float y = monstros->posYAnterior[i] + (monstros->posY[i] - monstros->posYAnterior[i]) * alfa;
+        if (x < minX || x > maxX || y < minY || y > maxY) continue;
+        saida[quantidade++] = i;
+    }
+    return quantidade;
+}
+
 void JogoDesenhar(EstadoJogo *estado,
                   const Jogador *jogador,
                   const Camera2D *camera,
-                  Mapa **mapa,
-                  Texture2D *tiles,
+                  const Mapa *mapa,
+                  const CamadaMapa *camadaMapa,
+                  const IdTextura *tiles,
                   int quantidadeTiles,
                   int idTileForaMapa,
-                  int linhasMapa,
-                  int colunasMapa,
-                  int tileLargura,
-                  int tileAltura,
                   int largura, int altura,
                   Font fonteNormal,
                   Font fonteBold,
@@ -596,52 +779,64 @@ void JogoDesenhar(EstadoJogo *estado,
                   const ArmaPrincipal *armaPrincipalAtual,
                   const ArmaSecundaria *armaSecundariaAtual,
                   Vector2 mousePos,
-                  bool mouseClick)
+                  bool mouseClick,
+                  float alfa)
 {
     if (!estado || !jogador || !camera) return;
     (void)fonteNormal;
     const float escalaUI = UI_GetEscala();
 
-    BeginMode2D(*camera);
-        DesenharMapaVisivel((Camera2D *)camera, largura, altura,
-                            mapa, linhasMapa, colunasMapa,
-                            tiles, quantidadeTiles,
-                            tileLargura, tileAltura,
-                            idTileForaMapa);
+    if (alfa < 0.0f) alfa = 0.0f;
+    if (alfa > 1.0f) alfa = 1.0f;
+    Vector2 posJogador = InterpolarV2(estado->posicaoAnteriorJogador, jogador->posicao, alfa);
+    Jogador jogadorQuadro = *jogador;
+    jogadorQuadro.posicao = posJogador;
+    Camera2D cameraQuadro = *camera;
+    cameraQuadro.target = posJogador;
+
+    BeginMode2D(cameraQuadro);
+        PERFIL_INICIO(PERFIL_DESENHO_MAPA);
+        if (camadaMapa && camadaMapa->pronta) {
+            DesenharCamadaMapa(camadaMapa, &cameraQuadro, largura, altura);
+        } else {
+            DesenharMapaVisivel(&cameraQuadro, largura, altura,
+                                mapa, tiles, quantidadeTiles, idTileForaMapa);
+        }
+        PERFIL_FIM(PERFIL_DESENHO_MAPA);
+
+        PERFIL_INICIO(PERFIL_DESENHO_ENTIDADES);
 
         DesenharEfeitoArmaPrincipal(&estado->efeitoArmaPrincipal);
-        UI_DesenharEfeitoArmaSecundaria(&estado->armaSecundaria, jogador->posicao);
-        if (estado->projetilRaygun.ativo) {
-            const ArmaPrincipal *armaProj = estado->projetilRaygun.arma;
-            float raioVisual = (armaProj && armaProj->raioProjetilVisual > 0.0f)
-                               ? armaProj->raioProjetilVisual
-                               : 6.0f;
-            Color corProjetil = (armaProj && armaProj->corProjetil.a != 0)
-                                ? armaProj->corProjetil
-                                : SKYBLUE;
-            DrawCircleV(estado->projetilRaygun.posicao, raioVisual, corProjetil);
-        }
-        DesenharJogador(jogador);
+        UI_DesenharEfeitoArmaSecundaria(&estado->armaSecundaria, posJogador);
+        Projeteis_Desenhar(&estado->projeteis, alfa);
+        DesenharJogador(&jogadorQuadro);
         if (capaceteAtual) {
-            DesenharCapacete(capaceteAtual, jogador->posicao, 1.0f);
+            DesenharCapacete(capaceteAtual, posJogador, 1.0f);
         }
         if (armaduraAtual) {
-            DesenharArmadura(armaduraAtual, jogador->posicao, jogador->emMovimento, jogador->alternarFrame, 1.0f);
+            DesenharArmadura(armaduraAtual, posJogador, jogador->emMovimento, jogador->alternarFrame, 1.0f);
         }
         if (armaSecundariaAtual) {
-            DesenharArmaSecundaria(armaSecundariaAtual, jogador->posicao, jogador->emMovimento, jogador->alternarFrame, 1.0f);
+            DesenharArmaSecundaria(armaSecundariaAtual, posJogador, jogador->emMovimento, jogador->alternarFrame, 1.0f);
         }
         if (armaPrincipalAtual) {
-            DesenharArmaPrincipal(armaPrincipalAtual, jogador->posicao, jogador->emMovimento, jogador->alternarFrame, 1.0f);
+            DesenharArmaPrincipal(armaPrincipalAtual, posJogador, jogador->emMovimento, jogador->alternarFrame, 1.0f);
         }
-        DesenharObjetosLancados(estado);
-        for (int i = 0; i < MAX_MONSTROS; ++i) {
-            if (estado->monstros[i].ativo) {
-                DesenharMonstro(&estado->monstros[i]);
-            }
+        DesenharObjetosLancados(estado, alfa);
+        size_t marca = Rascunho_Marca();
+        int *visiveis = RASCUNHO_VETOR(int, estado->monstros.quantidade);
+        if (visiveis) {
+            int quantidadeVisiveis = SelecionarMonstrosVisiveis(&estado->monstros, &cameraQuadro,
+                                                                largura, altura, alfa, visiveis);
+            DesenharMonstrosSelecionados(&estado->monstros, visiveis, quantidadeVisiveis, alfa);
+        } else {
+            DesenharMonstros(&estado->monstros, alfa);
         }
+        Rascunho_Voltar(marca);
+        PERFIL_FIM(PERFIL_DESENHO_ENTIDADES);
     EndMode2D();
 
+    PERFIL_INICIO(PERFIL_DESENHO_HUD);
     DrawText("ESC para pausar", 20, 20, UI_AjustarTamanhoFonteInt(20.0f), WHITE);
     DrawText(TextFormat("Pontos: %d", estado->pontuacaoTotal),
              20, 80, UI_AjustarTamanhoFonteInt(20.0f), GOLD);
@@ -702,9 +897,17 @@ void JogoDesenhar(EstadoJogo *estado,
             SolicitarRetornoMenu(estado);
         }
     }
+    PERFIL_FIM(PERFIL_DESENHO_HUD);
+
+    PERFIL_DESENHAR_OVERLAY(fonteNormal, largura, altura);
 }
 
 void JogoLiberarRecursos(EstadoJogo *estado)
 {
+    if (!estado) return;
     ResetarMonstros(estado);
+    ConjuntoMonstros_Liberar(&estado->monstros);
+    GradeEspacial_Liberar(&estado->gradeMonstros);
+    CampoFluxo_Liberar(&estado->campoFluxo);
+    Arena_Liberar(&estado->memoriaPartida);
 }
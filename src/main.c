@@ -1,6 +1,24 @@
 #include "app.h"
+#include "mapa.h"
+#include "simulacao.h"
+#include <stdlib.h>
+#include <string.h>
 
-int main(void)
+int main(int argc, char **argv)
 {
-    return AplicacaoExecutar();
+    // --gerar-mapa ARQ TAMANHO: grava uma arena quadrada para --mapa e sai
+    for (int i = 1; i + 2 < argc; ++i) {
+        if (strcmp(argv[i], "--gerar-mapa") == 0) {
+            int tamanho = atoi(argv[i + 2]);
+            return GravarMapaArquivo(argv[i + 1], tamanho, tamanho) ? 0 : 1;
+        }
+    }
+#ifdef MTA_HEADLESS
+    return SimulacaoExecutar(argc, argv);
+#else
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--headless") == 0) return SimulacaoExecutar(argc, argv);
+    }
+    return AplicacaoExecutar(argc, argv);
+#endif
 }
@@ -1,4 +1,6 @@
+#include <math.h>
 #include <stdlib.h>
+#include <string.h>
 #include "mapa.h"
 
 static inline int escolher_id_tile(int i, int j, int L, int C)
@@ -24,51 +26,85 @@ static inline bool eh_cercado(int id_tile)
     return id_tile <= 11;
 }
 
-Mapa **criar_mapa_encadeado(int L, int C, int tile_w, int tile_h)
+Mapa *criar_mapa(int L, int C, int tile_w, int tile_h)
 {
-    Mapa **linhas = (Mapa **)malloc(L * sizeof(Mapa *));
-    if (!linhas) return NULL;
+    if (L <= 0 || C <= 0) return NULL;
+    Mapa *mapa = (Mapa *)calloc(1, sizeof(Mapa));
+    if (!mapa) return NULL;
 
-    for (int i = 0; i < L; ++i) {
-        linhas[i] = (Mapa *)calloc(C, sizeof(Mapa));
-        if (!linhas[i]) {
-            for (int k = 0; k < i; ++k) free(linhas[k]);
-            free(linhas);
-            return NULL;
-        }
+    size_t total = (size_t)L * (size_t)C;
+    mapa->idsTile = (uint8_t *)malloc(total);
+    mapa->colisao = (uint32_t *)calloc((total + 31) / 32, sizeof(uint32_t));
+    if (!mapa->idsTile || !mapa->colisao) {
+        destruir_mapa(mapa);
+        return NULL;
     }
+    mapa->linhas = L;
+    mapa->colunas = C;
+    mapa->tileLargura = tile_w;
+    mapa->tileAltura = tile_h;
 
     for (int i = 0; i < L; ++i) {
         for (int j = 0; j < C; ++j) {
-            Mapa *no = &linhas[i][j];
-            no->linha  = i;
-            no->coluna = j;
-            no->id_tile = escolher_id_tile(i, j, L, C);
-            no->colisao = eh_cercado(no->id_tile);
-            no->posX = (float)j * (float)tile_w;
-            no->posY = (float)i * (float)tile_h;
-            no->cima = no->baixo = no->esquerda = no->direita = NULL;
+            size_t indice = (size_t)i * C + j;
+            int id = escolher_id_tile(i, j, L, C);
+            mapa->idsTile[indice] = (uint8_t)id;
+            if (eh_cercado(id)) mapa->colisao[indice >> 5] |= 1u << (indice & 31);
         }
     }
+    return mapa;
+}
 
-    for (int i = 0; i < L; ++i) {
-        for (int j = 0; j < C; ++j) {
-            Mapa *no = &linhas[i][j];
-            if (i > 0)     no->cima     = &linhas[i-1][j];
-            if (i < L - 1) no->baixo    = &linhas[i+1][j];
-            if (j > 0)     no->esquerda = &linhas[i][j-1];
-            if (j < C - 1) no->direita  = &linhas[i][j+1];
-        }
+void destruir_mapa(Mapa *mapa)
+{
+    if (!mapa) return;
+    RegioesMapa_Fechar(mapa->regioes);
+    free(mapa->idsTile);
+    free(mapa->colisao);
+    free(mapa);
+}
+
+static uint8_t GerarTileArena(int i, int j, int linhas, int colunas, bool *colisao)
+{
+    int id = escolher_id_tile(i, j, linhas, colunas);
+    *colisao = eh_cercado(id);
+    return (uint8_t)id;
+}
+
+bool GravarMapaArquivo(const char *caminho, int linhas, int colunas)
+{
+    return RegioesMapa_Gravar(caminho, linhas, colunas, GerarTileArena);
+}
+
+Mapa *AbrirMapaArquivo(const char *caminho, int tileLargura, int tileAltura)
+{
+    Mapa *mapa = (Mapa *)calloc(1, sizeof(Mapa));
+    if (!mapa) return NULL;
+    mapa->regioes = RegioesMapa_Abrir(caminho, &mapa->linhas, &mapa->colunas);
+    if (!mapa->regioes) {
+        free(mapa);
+        return NULL;
     }
+    mapa->tileLargura = tileLargura;
+    mapa->tileAltura = tileAltura;
+    return mapa;
+}
 
-    return linhas;
+void AtualizarRegioesMapa(Mapa *mapa, Vector2 posicao)
+{
+    if (!mapa || !mapa->regioes || mapa->tileLargura <= 0 || mapa->tileAltura <= 0) return;
+    RegioesMapa_Atualizar(mapa->regioes,
+                          (int)floorf(posicao.y / mapa->tileAltura),
+                          (int)floorf(posicao.x / mapa->tileLargura));
 }
 
-void destruir_mapa_encadeado(Mapa **linhas, int L)
+void AreaResidenteMapa(const Mapa *mapa, int *linha, int *coluna, int *linhas, int *colunas)
 {
-    if (!linhas) return;
-    for (int i = 0; i < L; ++i) free(linhas[i]);
-    free(linhas);
+    if (mapa->regioes && RegioesMapa_AreaResidente(mapa->regioes, linha, coluna, linhas, colunas)) return;
+    *linha = 0;
+    *coluna = 0;
+    *linhas = mapa->regioes ? 0 : mapa->linhas;
+    *colunas = mapa->regioes ? 0 : mapa->colunas;
 }
 
 bool ConverterPosicaoParaIndice(float posX, float posY, int tileLargura, int tileAltura,
@@ -87,21 +123,79 @@ bool ConverterPosicaoParaIndice(float posX, float posY, int tileLargura, int til
     return true;
 }
 
-bool TilePossuiColisao(Mapa **mapa, int linhas, int colunas, int i, int j)
+bool TilePossuiColisao(const Mapa *mapa, int i, int j)
 {
     if (!mapa) return true;
-    if (i < 0 || j < 0 || i >= linhas || j >= colunas) return true;
-    return mapa[i][j].colisao;
+    if (i < 0 || j < 0 || i >= mapa->linhas || j >= mapa->colunas) return true;
+    if (mapa->regioes) return RegioesMapa_Colisao(mapa->regioes, i, j);
+    size_t indice = (size_t)i * mapa->colunas + j;
+    return (mapa->colisao[indice >> 5] >> (indice & 31)) & 1u;
+}
+
+int IdTileMapa(const Mapa *mapa, int i, int j)
+{
+    if (!mapa || i < 0 || j < 0 || i >= mapa->linhas || j >= mapa->colunas) return -1;
+    if (mapa->regioes) return RegioesMapa_IdTile(mapa->regioes, i, j);
+    return mapa->idsTile[(size_t)i * mapa->colunas + j];
+}
+
+// Desenha os tiles [iIni..iFim] x [jIni..jFim] deslocados por `deslocamento`.
+// Fora do mapa vai a rua em escala 2x: cada uma cobre parte das vizinhas
+// seguintes, que são desenhadas por cima, então a ordem linha a linha importa.
+// Tiles de regiões ainda não lidas são tratados como fora do mapa.
+static int DesenharFaixaTiles(const Mapa *mapa, const IdTextura *tiles, int quantidadeTiles,
+                              int ruaIndex, int iIni, int iFim, int jIni, int jFim,
+                              Vector2 deslocamento)
+{
+    const int tileLargura = mapa->tileLargura;
+    const int tileAltura = mapa->tileAltura;
+    int desenhados = 0;
+    for (int i = iIni; i <= iFim; ++i) {
+        bool linhaDentro = (i >= 0 && i < mapa->linhas);
+        const uint8_t *linhaIds = (linhaDentro && mapa->idsTile) ? &mapa->idsTile[(size_t)i * mapa->colunas] : NULL;
+        for (int j = jIni; j <= jFim; ++j) {
+            bool dentro = (linhaDentro && j >= 0 && j < mapa->colunas);
+            int id = ruaIndex;
+            if (dentro) {
+                id = linhaIds ? linhaIds[j] : RegioesMapa_IdTile(mapa->regioes, i, j);
+                if (id < 0) {
+                    dentro = false;
+                    id = ruaIndex;
+                }
+            }
+            if (id < 0 || id >= quantidadeTiles) id = ruaIndex;
+
+            float posX = (float)j * tileLargura + deslocamento.x;
+            float posY = (float)i * tileAltura + deslocamento.y;
+            Vector2 pos = { posX, posY };
+            float escala = (!dentro && id == ruaIndex) ? 2.0f : 1.0f;
+            Texturas_DesenharSprite(Texturas_ObterSprite(tiles[id]), pos, escala, WHITE);
+            desenhados++;
+        }
+    }
+    return desenhados;
 }
 
-void DesenharMapaVisivel(Camera2D *camera, int telaLargura, int telaAltura,
-                         Mapa **mapa, int linhas, int colunas,
-                         Texture2D *tiles, int quantidadeTiles,
-                         int tileLargura, int tileAltura,
-                         int idTileForaMapa)
+static int IndiceRua(int idTileForaMapa, int quantidadeTiles)
 {
-    if (!camera || !mapa || !tiles || quantidadeTiles <= 0) return;
-    if (tileLargura <= 0 || tileAltura <= 0) return;
+    if (idTileForaMapa < 0 || idTileForaMapa >= quantidadeTiles) return quantidadeTiles - 1;
+    return idTileForaMapa;
+}
+
+// Divisão arredondando para baixo também para negativos (fora do mapa)
+static int DividirPiso(int a, int b)
+{
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+int DesenharMapaVisivel(Camera2D *camera, int telaLargura, int telaAltura,
+                        const Mapa *mapa, const IdTextura *tiles, int quantidadeTiles,
+                        int idTileForaMapa)
+{
+    if (!camera || !mapa || !tiles || quantidadeTiles <= 0) return 0;
+    const int tileLargura = mapa->tileLargura;
+    const int tileAltura = mapa->tileAltura;
+    if (tileLargura <= 0 || tileAltura <= 0) return 0;
 
     Vector2 topoEsquerdo = GetScreenToWorld2D((Vector2){0, 0}, *camera);
     Vector2 fundoDireito = GetScreenToWorld2D((Vector2){(float)telaLargura, (float)telaAltura}, *camera);
@@ -111,23 +205,100 @@ void DesenharMapaVisivel(Camera2D *camera, int telaLargura, int telaAltura,
     int jFim = (int)(fundoDireito.x / tileLargura) + 1;
     int iFim = (int)(fundoDireito.y / tileAltura) + 1;
 
-    int ruaIndex = idTileForaMapa;
-    if (ruaIndex < 0 || ruaIndex >= quantidadeTiles) ruaIndex = quantidadeTiles - 1;
+    return DesenharFaixaTiles(mapa, tiles, quantidadeTiles, IndiceRua(idTileForaMapa, quantidadeTiles),
+                              iIni, iFim, jIni, jFim, (Vector2){ 0.0f, 0.0f });
+}
 
-    for (int i = iIni; i <= iFim; ++i) {
-        for (int j = jIni; j <= jFim; ++j) {
-            bool dentro = (i >= 0 && j >= 0 && i < linhas && j < colunas);
-            int id = dentro ? mapa[i][j].id_tile : ruaIndex;
-            if (id < 0 || id >= quantidadeTiles) id = ruaIndex;
+static bool RenderizarChunk(RenderTexture2D *alvo, const Mapa *mapa,
+                            const IdTextura *tiles, int quantidadeTiles, int ruaIndex,
+                            int iIni, int jIni)
+{
+    *alvo = LoadRenderTexture(TILES_POR_CHUNK * mapa->tileLargura, TILES_POR_CHUNK * mapa->tileAltura);
+    if (alvo->id == 0) return false;
+    Vector2 deslocamento = { -(float)(jIni * mapa->tileLargura), -(float)(iIni * mapa->tileAltura) };
+    BeginTextureMode(*alvo);
+        ClearBackground(BLANK);
+        DesenharFaixaTiles(mapa, tiles, quantidadeTiles, ruaIndex,
+                           iIni, iIni + TILES_POR_CHUNK - 1, jIni, jIni + TILES_POR_CHUNK - 1,
+                           deslocamento);
+    EndTextureMode();
+    return true;
+}
 
-            float posX = (float)j * tileLargura;
-            float posY = (float)i * tileAltura;
-            Vector2 pos = { posX, posY };
-            if (!dentro && id == ruaIndex) {
-                DrawTextureEx(tiles[id], pos, 0.0f, 2.0f, WHITE);
-            } else {
-                DrawTextureV(tiles[id], pos, WHITE);
+bool CamadaMapa_Construir(CamadaMapa *camada, const Mapa *mapa,
+                          const IdTextura *tiles, int quantidadeTiles, int idTileForaMapa)
+{
+    if (!camada || !mapa || !tiles || quantidadeTiles <= 0) return false;
+    if (mapa->tileLargura <= 0 || mapa->tileAltura <= 0 || mapa->regioes) return false;
+    CamadaMapa_Liberar(camada);
+
+    camada->chunksLinhas = (mapa->linhas + TILES_POR_CHUNK - 1) / TILES_POR_CHUNK;
+    camada->chunksColunas = (mapa->colunas + TILES_POR_CHUNK - 1) / TILES_POR_CHUNK;
+    camada->tileLargura = mapa->tileLargura;
+    camada->tileAltura = mapa->tileAltura;
+    camada->chunks = (RenderTexture2D *)calloc((size_t)camada->chunksLinhas * camada->chunksColunas,
+                                               sizeof(RenderTexture2D));
+    if (!camada->chunks) return false;
+
+    const int ruaIndex = IndiceRua(idTileForaMapa, quantidadeTiles);
+    for (int ci = 0; ci < camada->chunksLinhas; ++ci) {
+        for (int cj = 0; cj < camada->chunksColunas; ++cj) {
+            RenderTexture2D *chunk = &camada->chunks[ci * camada->chunksColunas + cj];
+            if (!RenderizarChunk(chunk, mapa, tiles, quantidadeTiles, ruaIndex,
+                                 ci * TILES_POR_CHUNK, cj * TILES_POR_CHUNK)) {
+                CamadaMapa_Liberar(camada);
+                return false;
             }
         }
     }
+    // Fora do mapa todo tile é rua: um chunk qualquer de fora serve para todos
+    if (!RenderizarChunk(&camada->chunkForaMapa, mapa, tiles, quantidadeTiles, ruaIndex,
+                         -TILES_POR_CHUNK, -TILES_POR_CHUNK)) {
+        CamadaMapa_Liberar(camada);
+        return false;
+    }
+    camada->pronta = true;
+    return true;
+}
+
+void CamadaMapa_Liberar(CamadaMapa *camada)
+{
+    if (!camada) return;
+    if (camada->chunks) {
+        for (int k = 0; k < camada->chunksLinhas * camada->chunksColunas; ++k) {
+            if (camada->chunks[k].id != 0) UnloadRenderTexture(camada->chunks[k]);
+        }
+        free(camada->chunks);
+    }
+    if (camada->chunkForaMapa.id != 0) UnloadRenderTexture(camada->chunkForaMapa);
+    memset(camada, 0, sizeof(*camada));
+}
+
+int DesenharCamadaMapa(const CamadaMapa *camada, const Camera2D *camera, int telaLargura, int telaAltura)
+{
+    if (!camada || !camada->pronta || !camera) return 0;
+
+    const int larguraPx = TILES_POR_CHUNK * camada->tileLargura;
+    const int alturaPx = TILES_POR_CHUNK * camada->tileAltura;
+    Vector2 topoEsquerdo = GetScreenToWorld2D((Vector2){0, 0}, *camera);
+    Vector2 fundoDireito = GetScreenToWorld2D((Vector2){(float)telaLargura, (float)telaAltura}, *camera);
+    int cjIni = DividirPiso((int)floorf(topoEsquerdo.x), larguraPx);
+    int ciIni = DividirPiso((int)floorf(topoEsquerdo.y), alturaPx);
+    int cjFim = DividirPiso((int)floorf(fundoDireito.x), larguraPx);
+    int ciFim = DividirPiso((int)floorf(fundoDireito.y), alturaPx);
+
+    // Render textures ficam de cabeça para baixo: altura negativa na origem
+    const Rectangle origem = { 0.0f, 0.0f, (float)larguraPx, -(float)alturaPx };
+    int desenhados = 0;
+    for (int ci = ciIni; ci <= ciFim; ++ci) {
+        for (int cj = cjIni; cj <= cjFim; ++cj) {
+            bool dentro = (ci >= 0 && cj >= 0 && ci < camada->chunksLinhas && cj < camada->chunksColunas);
+            const RenderTexture2D *chunk = dentro ? &camada->chunks[ci * camada->chunksColunas + cj]
+                                                  : &camada->chunkForaMapa;
+            DrawTextureRec(chunk->texture, origem,
+                           (Vector2){ (float)(cj * larguraPx), (float)(ci * alturaPx) }, WHITE);
+            desenhados++;
+        }
+    }
+    return desenhados;
 }
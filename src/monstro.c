@@ -3,165 +3,278 @@
 #include "objeto.h"
 #include "jogador.h"
 #include "mapa.h"
+#include "campo_fluxo.h"
+#include "grade_espacial.h"
+#include "testes_acerto.h"
+#include "arena.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 #include <float.h>
 
-void CarregarAssetsMonstro(Monstro *m)
+#define FORCA_MAXIMA_SEPARACAO 3.0f
+
+static IdTextura gTexturasTipo[MONSTRO_TIPOS_COUNT][3];
+static IdTextura gTexturasObjetoTipo[MONSTRO_TIPOS_COUNT];
+
+bool CarregarTexturasMonstros(void)
 {
-    if (!m) return;
-    const MonstroInfo *info = ObterInfoMonstro(m->tipo);
-    if (!info) return;
-
-    for (int i = 0; i < 3; ++i) {
-        if (!info->sprites[i]) continue;
-        Texture2D sprite = LoadTexture(info->sprites[i]);
-        if (sprite.id == 0) continue;
-        switch (i) {
-            case 0: m->sprite1 = sprite; break;
-            case 1: m->sprite2 = sprite; break;
-            case 2: m->sprite3 = sprite; break;
+    bool sucesso = true;
+    for (int t = 0; t < MONSTRO_TIPOS_COUNT; ++t) {
+        const MonstroInfo *info = ObterInfoMonstro((TipoMonstro)t);
+        if (!info) continue;
+        for (int i = 0; i < 3; ++i) {
+            gTexturasTipo[t][i] = Texturas_Carregar(info->sprites[i]);
+            if (info->sprites[i] && gTexturasTipo[t][i] == TEXTURA_NENHUMA) sucesso = false;
+        }
+        if (info->possuiObjeto) {
+            gTexturasObjetoTipo[t] = Texturas_Carregar(info->spriteObjeto);
+            if (gTexturasObjetoTipo[t] == TEXTURA_NENHUMA) sucesso = false;
         }
     }
+    return sucesso;
 }
 
-bool IniciarMonstro(Monstro *m,
-                    Vector2 posInicial,
-                    const MonstroInfo *info)
+void DescarregarTexturasMonstros(void)
 {
-    if (!m || !info)
-        return false;
-
-    m->posicao = posInicial;
-    m->vidaMaxima = info->vida;
-    m->vida = info->vida;
-    m->velocidade = info->velocidade;
-    m->tipo = info->tipo;
-    m->ativo = true;
+    for (int t = 0; t < MONSTRO_TIPOS_COUNT; ++t) {
+        for (int i = 0; i < 3; ++i) {
+            Texturas_Liberar(gTexturasTipo[t][i]);
+            gTexturasTipo[t][i] = TEXTURA_NENHUMA;
+        }
+        Texturas_Liberar(gTexturasObjetoTipo[t]);
+        gTexturasObjetoTipo[t] = TEXTURA_NENHUMA;
+    }
+}
 
-    memset(&m->sprite1, 0, sizeof(Texture2D) * 3);
+IdTextura ObterSpriteObjetoMonstro(TipoMonstro tipo)
+{
+    if (tipo < 0 || tipo >= MONSTRO_TIPOS_COUNT) return TEXTURA_NENHUMA;
+    return gTexturasObjetoTipo[tipo];
+}
 
-    m->fpsAnimacao = info->fpsAnimacao;
-    m->acumulador = 0.0f;
-    m->frameAtual = 1;
+static bool RedimensionarColuna(void **coluna, size_t tamanhoElemento, int capacidade)
+{
+    void *nova = realloc(*coluna, tamanhoElemento * (size_t)capacidade);
+    if (!nova) return false;
+    *coluna = nova;
+    return true;
+}
 
-    m->alcanceAtaque = info->alcanceAtaque;
-    m->cooldownAtaque = info->cooldownAtaque;
-    m->acumuladorAtaque = 0.0f;
-    m->danoContato = info->danoContato;
-    m->pontuacao = info->pontuacao;
+static bool GarantirCapacidadeMonstros(ConjuntoMonstros *c, int necessario)
+{
+    if (necessario <= c->capacidade) return true;
+    if (c->capacidadeFixa) return false;
+    int capacidade = (c->capacidade > 0) ? c->capacidade : LIMITE_MONSTROS_PADRAO;
+    while (capacidade < necessario) capacidade *= 2;
+
+    // Se uma coluna falhar as anteriores já cresceram; a capacidade antiga continua válida em todas
+    if (!RedimensionarColuna((void **)&c->posX, sizeof(float), capacidade) ||
+        !RedimensionarColuna((void **)&c->posY, sizeof(float), capacidade) ||
+        !RedimensionarColuna((void **)&c->posXAnterior, sizeof(float), capacidade) ||
+        !RedimensionarColuna((void **)&c->posYAnterior, sizeof(float), capacidade) ||
+        !RedimensionarColuna((void **)&c->velX, sizeof(float), capacidade) ||
+        !RedimensionarColuna((void **)&c->velY, sizeof(float), capacidade) ||
+        !RedimensionarColuna((void **)&c->vida, sizeof(float), capacidade) ||
+        !RedimensionarColuna((void **)&c->fatorVelocidade, sizeof(float), capacidade) ||
+        !RedimensionarColuna((void **)&c->tipo, sizeof(unsigned char), capacidade) ||
+        !RedimensionarColuna((void **)&c->acumuladorAnimacao, sizeof(float), capacidade) ||
+        !RedimensionarColuna((void **)&c->frame, sizeof(unsigned char), capacidade) ||
+        !RedimensionarColuna((void **)&c->acumuladorAtaque, sizeof(float), capacidade) ||
+        !RedimensionarColuna((void **)&c->acumuladorArremesso, sizeof(float), capacidade) ||
+        !RedimensionarColuna((void **)&c->intencao, sizeof(unsigned char), capacidade)) {
+        printf("Erro: sem memoria para %d monstros\n", capacidade);
+        return false;
+    }
+    c->capacidade = capacidade;
+    return true;
+}
 
-    m->cooldownArremesso = info->cooldownArremesso;
-    m->acumuladorArremesso = 0.0f;
-    
-    m->objeto = NULL;
-    if (info->possuiObjeto && info->spriteObjeto) {
-        m->objeto = (struct ObjetoLancavel *)malloc(sizeof(ObjetoLancavel));
-        if (!m->objeto){
-            return false;
-        }
+bool ConjuntoMonstros_Inicializar(ConjuntoMonstros *c, int capacidadeInicial)
+{
+    if (!c) return false;
+    memset(c, 0, sizeof(*c));
+    if (capacidadeInicial <= 0) capacidadeInicial = LIMITE_MONSTROS_PADRAO;
+    return GarantirCapacidadeMonstros(c, capacidadeInicial);
+}
 
-        memset(m->objeto, 0, sizeof(ObjetoLancavel));
-        m->objeto->dano = info->danoObjeto;
-        m->objeto->velocidade = info->velocidadeObjeto;
+// 11 colunas de float e 3 de byte, cada uma alinhada pela arena
+size_t ConjuntoMonstros_TamanhoArena(int capacidade)
+{
+    if (capacidade <= 0) capacidade = LIMITE_MONSTROS_PADRAO;
+    return 11 * ARENA_TAMANHO(sizeof(float) * (size_t)capacidade) +
+           3 * ARENA_TAMANHO(sizeof(unsigned char) * (size_t)capacidade);
+}
 
-        if(!IniciarObjeto(m->objeto, info->spriteObjeto)){
-            free(m->objeto);
-            m->objeto = NULL; 
-        }
+bool ConjuntoMonstros_InicializarArena(ConjuntoMonstros *c, int capacidade, Arena *arena)
+{
+    if (!c || !arena) return false;
+    memset(c, 0, sizeof(*c));
+    if (capacidade <= 0) capacidade = LIMITE_MONSTROS_PADRAO;
+    size_t nf = sizeof(float) * (size_t)capacidade;
+    size_t nb = sizeof(unsigned char) * (size_t)capacidade;
+    c->posX = (float *)Arena_Alocar(arena, nf);
+    c->posY = (float *)Arena_Alocar(arena, nf);
+    c->posXAnterior = (float *)Arena_Alocar(arena, nf);
+    c->posYAnterior = (float *)Arena_Alocar(arena, nf);
+    c->velX = (float *)Arena_Alocar(arena, nf);
+    c->velY = (float *)Arena_Alocar(arena, nf);
+    c->vida = (float *)Arena_Alocar(arena, nf);
+    c->fatorVelocidade = (float *)Arena_Alocar(arena, nf);
+    c->tipo = (unsigned char *)Arena_Alocar(arena, nb);
+    c->acumuladorAnimacao = (float *)Arena_Alocar(arena, nf);
+    c->frame = (unsigned char *)Arena_Alocar(arena, nb);
+    c->acumuladorAtaque = (float *)Arena_Alocar(arena, nf);
+    c->acumuladorArremesso = (float *)Arena_Alocar(arena, nf);
+    c->intencao = (unsigned char *)Arena_Alocar(arena, nb);
+    c->capacidadeFixa = true;
+    if (!c->posX || !c->posY || !c->posXAnterior || !c->posYAnterior || !c->velX || !c->velY ||
+        !c->vida || !c->fatorVelocidade || !c->tipo || !c->acumuladorAnimacao || !c->frame ||
+        !c->acumuladorAtaque || !c->acumuladorArremesso || !c->intencao) {
+        printf("Erro: arena sem espaco para %d monstros\n", capacidade);
+        memset(c, 0, sizeof(*c));
+        c->capacidadeFixa = true;
+        return false;
     }
-
+    c->capacidade = capacidade;
     return true;
 }
 
-void DescarregarMonstro(Monstro *m)
+void ConjuntoMonstros_Liberar(ConjuntoMonstros *c)
 {
-    if (!m)
+    if (!c) return;
+    if (c->capacidadeFixa) {
+        // As colunas são da arena de quem chamou
+        memset(c, 0, sizeof(*c));
         return;
+    }
+    free(c->posX);
+    free(c->posY);
+    free(c->posXAnterior);
+    free(c->posYAnterior);
+    free(c->velX);
+    free(c->velY);
+    free(c->vida);
+    free(c->fatorVelocidade);
+    free(c->tipo);
+    free(c->acumuladorAnimacao);
+    free(c->frame);
+    free(c->acumuladorAtaque);
+    free(c->acumuladorArremesso);
+    free(c->intencao);
+    memset(c, 0, sizeof(*c));
+}
 
-    if (m->sprite1.id != 0)
-        UnloadTexture(m->sprite1);
-    if (m->sprite2.id != 0)
-        UnloadTexture(m->sprite2);
-    if (m->sprite3.id != 0)
-        UnloadTexture(m->sprite3);
+void ConjuntoMonstros_Limpar(ConjuntoMonstros *c)
+{
+    if (!c) return;
+    c->quantidade = 0;
+}
 
-    if (m->objeto)
-    {
-        DescarregarObjeto(m->objeto);
-        free(m->objeto);
-        m->objeto = NULL;
-    }
+int AdicionarMonstro(ConjuntoMonstros *c, Vector2 posInicial, const MonstroInfo *info)
+{
+    if (!c || !info) return -1;
+    if (!GarantirCapacidadeMonstros(c, c->quantidade + 1)) return -1;
+
+    int i = c->quantidade++;
+    c->posX[i] = posInicial.x;
+    c->posY[i] = posInicial.y;
+    c->posXAnterior[i] = posInicial.x;
+    c->posYAnterior[i] = posInicial.y;
+    c->velX[i] = 0.0f;
+    c->velY[i] = 0.0f;
+    c->vida[i] = info->vida;
+    c->fatorVelocidade[i] = 1.0f;
+    c->tipo[i] = (unsigned char)info->tipo;
+    c->acumuladorAnimacao[i] = 0.0f;
+    c->frame[i] = 0;
+    c->acumuladorAtaque[i] = 0.0f;
+    c->acumuladorArremesso[i] = 0.0f;
+    c->intencao[i] = 0;
+    return i;
+}
 
-    memset(m, 0, sizeof(*m));
+void RemoverMonstro(ConjuntoMonstros *c, int indice)
+{
+    if (!c || indice < 0 || indice >= c->quantidade) return;
+    int ultimo = --c->quantidade;
+    if (indice == ultimo) return;
+
+    c->posX[indice] = c->posX[ultimo];
+    c->posY[indice] = c->posY[ultimo];
+    c->posXAnterior[indice] = c->posXAnterior[ultimo];
+    c->posYAnterior[indice] = c->posYAnterior[ultimo];
+    c->velX[indice] = c->velX[ultimo];
+    c->velY[indice] = c->velY[ultimo];
+    c->vida[indice] = c->vida[ultimo];
+    c->fatorVelocidade[indice] = c->fatorVelocidade[ultimo];
+    c->tipo[indice] = c->tipo[ultimo];
+    c->acumuladorAnimacao[indice] = c->acumuladorAnimacao[ultimo];
+    c->frame[indice] = c->frame[ultimo];
+    c->acumuladorAtaque[indice] = c->acumuladorAtaque[ultimo];
+    c->acumuladorArremesso[indice] = c->acumuladorArremesso[ultimo];
+    c->intencao[indice] = c->intencao[ultimo];
 }
 
-void AtualizarMonstro(Monstro *m, float dt)
+void AtualizarTemporizadoresMonstros(ConjuntoMonstros *c, int inicio, int fim, float dt)
 {
-    if (!m || m->vida <= 0)
-        return;
+    if (!c) return;
+    for (int i = inicio; i < fim; ++i) {
+        if (c->vida[i] <= 0.0f) continue;
+        const MonstroInfo *info = &gMonstrosInfo[c->tipo[i]];
+
+        // Atualiza animação
+        float intervalo = 1.0f / info->fpsAnimacao;
+        c->acumuladorAnimacao[i] += dt;
+        if (c->acumuladorAnimacao[i] >= intervalo) {
+            c->acumuladorAnimacao[i] -= intervalo;
+            c->frame[i] = (unsigned char)((c->frame[i] + 1) % 3);
+        }
 
-    // Atualiza animação
-    float intervalo = 1.0f / m->fpsAnimacao;
-    m->acumulador += dt;
-    if (m->acumulador >= intervalo)
-    {
-        m->acumulador -= intervalo;
-        m->frameAtual++;
-        if (m->frameAtual > 3)
-            m->frameAtual = 1;
+        // Atualiza cooldown de ataque
+        if (c->acumuladorAtaque[i] > 0.0f) c->acumuladorAtaque[i] -= dt;
+        if (c->acumuladorArremesso[i] > 0.0f) c->acumuladorArremesso[i] -= dt;
     }
+}
 
-    // Atualiza cooldown de ataque
-    if (m->acumuladorAtaque > 0)
-        m->acumuladorAtaque -= dt;
-
-    if (m->acumuladorArremesso > 0)
-        m->acumuladorArremesso -= dt;
+void ArmazenarPosicoesAnterioresMonstros(ConjuntoMonstros *c)
+{
+    if (!c || c->quantidade <= 0) return;
+    memcpy(c->posXAnterior, c->posX, sizeof(float) * (size_t)c->quantidade);
+    memcpy(c->posYAnterior, c->posY, sizeof(float) * (size_t)c->quantidade);
 }
 
-void DesenharMonstro(const Monstro *m)
+static void DesenharMonstro(const ConjuntoMonstros *c, int i, float alfa)
 {
-    if (!m)
-        return;
+    const float escala = 2.0f; // Dobra o tamanho do monstro
 
-    Texture2D spriteAtual = m->sprite1;
-    switch (m->frameAtual)
-    {
-    case 1:
-        spriteAtual = m->sprite1;
-        break;
-    case 2:
-        spriteAtual = m->sprite2;
-        break;
-    case 3:
-        spriteAtual = m->sprite3;
-        break;
-    }
-    if (spriteAtual.id == 0) return;
-    float escala = 2.0f; // Dobra o tamanho do monstro
+    SpriteTextura spriteAtual = Texturas_ObterSprite(gTexturasTipo[c->tipo[i]][c->frame[i]]);
+    if (spriteAtual.textura.id == 0) return;
 
+    float x = c->posXAnterior[i] + (c->posX[i] - c->posXAnterior[i]) * alfa;
+    float y = c->posYAnterior[i] + (c->posY[i] - c->posYAnterior[i]) * alfa;
     Vector2 posSprite = {
-        m->posicao.x - (spriteAtual.width * escala) / 2.0f,
-        m->posicao.y - (spriteAtual.height * escala) / 2.0f
+        x - (spriteAtual.origem.width * escala) / 2.0f,
+        y - (spriteAtual.origem.height * escala) / 2.0f
     };
 
-    DrawTextureEx(spriteAtual, posSprite, 0.0f, escala, WHITE);
+    Texturas_DesenharSprite(spriteAtual, posSprite, escala, WHITE);
 
-    if (m->vidaMaxima > 0.0f) {
-        float barraLarg = spriteAtual.width * escala * 0.7f;
+    float vidaMaxima = gMonstrosInfo[c->tipo[i]].vida;
+    if (vidaMaxima > 0.0f) {
+        float barraLarg = spriteAtual.origem.width * escala * 0.7f;
         float barraAlt = 6.0f;
         float topoSprite = posSprite.y;
         Rectangle fundo = {
-            m->posicao.x - barraLarg / 2.0f,
+            x - barraLarg / 2.0f,
             topoSprite - barraAlt - 6.0f,
             barraLarg,
             barraAlt
         };
         DrawRectangleRec(fundo, (Color){30, 30, 30, 220});
 
-        float proporcao = m->vida / m->vidaMaxima;
+        float proporcao = c->vida[i] / vidaMaxima;
         if (proporcao < 0.0f) proporcao = 0.0f;
         if (proporcao > 1.0f) proporcao = 1.0f;
         Rectangle barra = fundo;
@@ -170,25 +283,45 @@ void DesenharMonstro(const Monstro *m)
     }
 }
 
-Vector2 GerarMonstros(struct Jogador *jogador, int mapL, int mapC, int tileW, int tileH)
+void DesenharMonstros(const ConjuntoMonstros *c, float alfa)
+{
+    if (!c) return;
+    for (int i = 0; i < c->quantidade; ++i) {
+        DesenharMonstro(c, i, alfa);
+    }
+}
+
+void DesenharMonstrosSelecionados(const ConjuntoMonstros *c, const int *indices, int quantidade, float alfa)
+{
+    if (!c || !indices) return;
+    for (int k = 0; k < quantidade; ++k) {
+        DesenharMonstro(c, indices[k], alfa);
+    }
+}
+
+Vector2 GerarMonstros(struct Jogador *jogador, int mapL, int mapC, int tileW, int tileH,
+                      GeradorAleatorio *aleatorio)
 {
     Vector2 resultado = {0, 0};
 
-    if (jogador == NULL || jogador->noAtual == NULL)
+    if (jogador == NULL || jogador->linhaAtual < 0)
         return resultado;
 
-    int jl = jogador->noAtual->linha;
-    int jc = jogador->noAtual->coluna;
+    int jl = jogador->linhaAtual;
+    int jc = jogador->colunaAtual;
 
     // Distância mínima (em tiles) do jogador para o spawn. 
     // 15 tiles deve ser suficiente para garantir que o monstro nasça fora da tela.
     const int DISTANCIA_MINIMA_TILES = 15; 
+    // Em mapas grandes o spawn fica a até 64 tiles do jogador, dentro das
+    // regiões carregadas; na arena padrão isso já cobre o mapa todo.
+    const int DISTANCIA_MAXIMA_TILES = 64;
     
     // Limites de busca (a área de grama, excluindo cercas)
-    const int LINHA_MIN_MAP = 1;
-    const int LINHA_MAX_MAP = mapL - 2;
-    const int COLUNA_MIN_MAP = 1;
-    const int COLUNA_MAX_MAP = mapC - 2;
+    const int LINHA_MIN_MAP = (jl - DISTANCIA_MAXIMA_TILES > 1) ? jl - DISTANCIA_MAXIMA_TILES : 1;
+    const int LINHA_MAX_MAP = (jl + DISTANCIA_MAXIMA_TILES < mapL - 2) ? jl + DISTANCIA_MAXIMA_TILES : mapL - 2;
+    const int COLUNA_MIN_MAP = (jc - DISTANCIA_MAXIMA_TILES > 1) ? jc - DISTANCIA_MAXIMA_TILES : 1;
+    const int COLUNA_MAX_MAP = (jc + DISTANCIA_MAXIMA_TILES < mapC - 2) ? jc + DISTANCIA_MAXIMA_TILES : mapC - 2;
 
     int linha, coluna;
     int maxTentativas = 300; // Aumentar tentativas para ser robusto
@@ -196,8 +329,8 @@ Vector2 GerarMonstros(struct Jogador *jogador, int mapL, int mapC, int tileW, in
     while (maxTentativas-- > 0)
     {
         // 1. Escolhe um ponto aleatório em qualquer lugar da área jogável do mapa.
-        linha = GetRandomValue(LINHA_MIN_MAP, LINHA_MAX_MAP);
-        coluna = GetRandomValue(COLUNA_MIN_MAP, COLUNA_MAX_MAP);
+        linha = Aleatorio_Intervalo(aleatorio, LINHA_MIN_MAP, LINHA_MAX_MAP);
+        coluna = Aleatorio_Intervalo(aleatorio, COLUNA_MIN_MAP, COLUNA_MAX_MAP);
         
         // 2. Calcula a distância em tiles (dl = delta linha, dc = delta coluna)
         int dl = abs(linha - jl);
@@ -222,87 +355,191 @@ Vector2 GerarMonstros(struct Jogador *jogador, int mapL, int mapC, int tileW, in
     return resultado;
 }
 
-// IA básica: move continuamente em direção ao jogador
-void IAAtualizarMonstro(Monstro *m, struct Jogador *jogador, float dt)
+// Empurrão para longe dos vizinhos a menos de `raio`, mais forte quanto mais
+// perto, em múltiplos da velocidade do monstro. Precisa poder vencer a
+// perseguição, senão o miolo da horda continua sendo esmagado sobre o
+// jogador. Lê só posições do início do passo, então o resultado não depende
+// da ordem dos monstros.
+static Vector2 ForcaSeparacao(const ConjuntoMonstros *c, const GradeEspacial *grade, int i, float raio)
 {
-    if (!m || !m->ativo || !jogador)
-        return;
+    int vizinhos[MAX_VIZINHOS_SEPARACAO];
+    Vector2 p = { c->posX[i], c->posY[i] };
+    int n = GradeEspacial_ConsultarCirculo(grade, p, raio, vizinhos, MAX_VIZINHOS_SEPARACAO);
+
+    Vector2 forca = { 0.0f, 0.0f };
+    for (int k = 0; k < n; ++k) {
+        int j = vizinhos[k];
+        if (j == i) continue;
+        float dx = p.x - c->posX[j];
+        float dy = p.y - c->posY[j];
+        float d2 = dx * dx + dy * dy;
+        if (d2 < 1e-6f) {
+            // Empilhados no mesmo ponto: cada um sai num ângulo fixo pelo índice
+            float angulo = (float)(i > j ? i : -i - 1) * 2.3999632f;
+            forca.x += cosf(angulo);
+            forca.y += sinf(angulo);
+            continue;
+        }
+        float d = sqrtf(d2);
+        float peso = (raio - d) / (raio * d);
+        forca.x += dx * peso;
+        forca.y += dy * peso;
+    }
+    float modulo2 = forca.x * forca.x + forca.y * forca.y;
+    if (modulo2 > FORCA_MAXIMA_SEPARACAO * FORCA_MAXIMA_SEPARACAO) {
+        float escala = FORCA_MAXIMA_SEPARACAO / sqrtf(modulo2);
+        forca.x *= escala;
+        forca.y *= escala;
+    }
+    return forca;
+}
 
-    // Calcula distância entre monstro e jogador
-    float dx = jogador->posicao.x - m->posicao.x;
-    float dy = jogador->posicao.y - m->posicao.y;
-    float distancia = sqrtf(dx * dx + dy * dy);
-    if (distancia <= 0.01f)
-        return;
+// IA básica: move continuamente em direção ao jogador, seguindo o campo de
+// fluxo quando não há linha de visão, e se afasta dos vizinhos mais próximos
+// que `raioSeparacao`. Lê a posição de qualquer monstro mas só escreve a
+// velocidade dos índices [inicio, fim): lotes disjuntos podem rodar em
+// paralelo, desde que nenhum integre posições antes de todos terminarem.
+void IACalcularVelocidadesMonstros(ConjuntoMonstros *c, int inicio, int fim, Vector2 alvo,
+                                   const CampoFluxo *campo, const GradeEspacial *grade,
+                                   float raioSeparacao)
+{
+    if (!c) return;
+    const float margemSeguranca = 25.0f;
+    const bool separar = grade && raioSeparacao > 0.0f;
+
+    for (int i = inicio; i < fim; ++i) {
+        c->velX[i] = 0.0f;
+        c->velY[i] = 0.0f;
+        if (c->vida[i] <= 0.0f) continue;
+
+        const MonstroInfo *info = &gMonstrosInfo[c->tipo[i]];
+        float velocidade = info->velocidade * c->fatorVelocidade[i];
+        if (separar) {
+            Vector2 separacao = ForcaSeparacao(c, grade, i, raioSeparacao);
+            c->velX[i] = separacao.x * velocidade;
+            c->velY[i] = separacao.y * velocidade;
+        }
+
+        // Calcula distância entre monstro e jogador
+        float dx = alvo.x - c->posX[i];
+        float dy = alvo.y - c->posY[i];
+        float distancia = sqrtf(dx * dx + dy * dy);
+        if (distancia <= 0.01f) continue;
+
+        bool ehArqueiro = (info->tipo == MONSTRO_ESQUELETO || info->tipo == MONSTRO_IT);
+        if (ehArqueiro) {
+            float alcanceParada = (info->alcanceAtaque > margemSeguranca)
+                                  ? info->alcanceAtaque - margemSeguranca
+                                  : info->alcanceAtaque;
+            if (alcanceParada < 150.0f) alcanceParada = 150.0f;
+            if (distancia <= alcanceParada) continue;
+        }
 
-    bool ehArqueiro = (m->tipo == MONSTRO_ESQUELETO || m->tipo == MONSTRO_IT);
-    if (ehArqueiro) {
-        const float margemSeguranca = 25.0f;
-        float alcanceParada = (m->alcanceAtaque > margemSeguranca)
-                              ? m->alcanceAtaque - margemSeguranca
-                              : m->alcanceAtaque;
-        if (alcanceParada < 150.0f) alcanceParada = 150.0f;
-        if (distancia <= alcanceParada) {
-            return;
+        Vector2 desvio;
+        if (CampoFluxo_Desvio(campo, (Vector2){ c->posX[i], c->posY[i] }, &desvio)) {
+            c->velX[i] += desvio.x * velocidade;
+            c->velY[i] += desvio.y * velocidade;
+        } else {
+            c->velX[i] += dx / distancia * velocidade;
+            c->velY[i] += dy / distancia * velocidade;
         }
     }
+}
+
+void IAIntegrarMonstros(ConjuntoMonstros *c, int inicio, int fim, float dt)
+{
+    if (!c) return;
+    for (int i = inicio; i < fim; ++i) {
+        c->posX[i] += c->velX[i] * dt;
+        c->posY[i] += c->velY[i] * dt;
+    }
+}
 
-    float dirX = dx / distancia;
-    float dirY = dy / distancia;
-    m->posicao.x += dirX * m->velocidade * dt;
-    m->posicao.y += dirY * m->velocidade * dt;
+// A velocidade é calculada para todos os monstros e só depois integrada,
+// para que cada laço toque apenas as colunas de que precisa.
+void IAAtualizarMonstros(ConjuntoMonstros *c, Vector2 alvo, const CampoFluxo *campo,
+                         const GradeEspacial *grade, float raioSeparacao, float dt)
+{
+    if (!c) return;
+    IACalcularVelocidadesMonstros(c, 0, c->quantidade, alvo, campo, grade, raioSeparacao);
+    IAIntegrarMonstros(c, 0, c->quantidade, dt);
 }
 
-// Colisão: Retorna true se o monstro colidiu com o jogador
-bool VerificarColisaoMonstroJogador(Monstro *m, struct Jogador *jogador)
+// Colisão: Retorna true se o monstro encostou no jogador durante o passo.
+// Usa os trajetos dos dois desde o início do passo, então um monstro rápido
+// (Randall) não atravessa o jogador sem contato num passo longo.
+bool VerificarColisaoMonstroJogador(const ConjuntoMonstros *c, int indice, const struct Jogador *jogador,
+                                    Vector2 posicaoAnteriorJogador)
 {
-    if (!m || !m->ativo || !jogador)
+    if (!c || indice < 0 || indice >= c->quantidade || !jogador)
         return false;
 
     // Define raio de colisão (metade da largura do sprite)
     float raioColisao = 20.0f;
+    float soma = raioColisao * 2;
 
-    float dx = m->posicao.x - jogador->posicao.x;
-    float dy = m->posicao.y - jogador->posicao.y;
-    float distancia = sqrtf(dx * dx + dy * dy);
+    Vector2 inicio = { c->posXAnterior[indice] - posicaoAnteriorJogador.x,
+                       c->posYAnterior[indice] - posicaoAnteriorJogador.y };
+    Vector2 fim = { c->posX[indice] - jogador->posicao.x, c->posY[indice] - jogador->posicao.y };
 
-    // Colide se a distância é menor que a soma dos raios
-    return distancia < (raioColisao * 2);
+    // Colide se a menor distância no passo é menor que a soma dos raios
+    return TestesAcerto_DistanciaSegmento2(inicio, fim, (Vector2){ 0.0f, 0.0f }) < soma * soma;
 }
 
-bool TentarLancarObjeto(Monstro *m, float dt, Vector2 alvo) {
-    if (!m || !m->objeto) return false;
-    
-    if (m->objeto->ativo) {
-        return false;
-    }
-    
-    if (m->acumuladorArremesso > 0.0f) {
-        m->acumuladorArremesso -= dt;
-        if (m->acumuladorArremesso > 0.0f) {
+// Recarga do arremesso e teste de alcance; zera a recarga quando arremessa
+static bool AtualizarArremesso(ConjuntoMonstros *c, int indice, float dt, Vector2 alvo)
+{
+    const MonstroInfo *info = &gMonstrosInfo[c->tipo[indice]];
+    if (!info->possuiObjeto) return false;
+
+    float *acumulador = &c->acumuladorArremesso[indice];
+    if (*acumulador > 0.0f) {
+        *acumulador -= dt;
+        if (*acumulador > 0.0f) {
             return false;
         }
     }
-    
-    float dx = alvo.x - m->posicao.x;
-    float dy = alvo.y - m->posicao.y;
+
+    float dx = alvo.x - c->posX[indice];
+    float dy = alvo.y - c->posY[indice];
     float distancia = sqrtf(dx * dx + dy * dy);
     if (distancia <= 0.01f) {
         return false;
     }
 
-    if (distancia > m->alcanceAtaque) {
+    if (distancia > info->alcanceAtaque) {
         return false;
     }
-    
-    if (m->acumuladorArremesso <= 0.0f) {
-        m->acumuladorArremesso = m->cooldownArremesso; 
-        
-        m->objeto->posicao = m->posicao;
-        m->objeto->direcao = (Vector2){dx / distancia, dy / distancia}; 
-        m->objeto->ativo = true;
-        
-        return true;
+
+    *acumulador = info->cooldownArremesso;
+    return true;
+}
+
+void GerarIntencoesMonstros(ConjuntoMonstros *c, int inicio, int fim, float dt, const struct Jogador *jogador,
+                            Vector2 posicaoAnteriorJogador)
+{
+    if (!c || !jogador) return;
+    for (int i = inicio; i < fim; ++i) {
+        unsigned char intencao = 0;
+        if (AtualizarArremesso(c, i, dt, jogador->posicao)) intencao |= INTENCAO_ARREMESSO;
+        if (VerificarColisaoMonstroJogador(c, i, jogador, posicaoAnteriorJogador) && c->acumuladorAtaque[i] <= 0.0f) {
+            intencao |= INTENCAO_CONTATO;
+        }
+        c->intencao[i] = intencao;
     }
-    return false;
+}
+
+void PrepararObjetoMonstro(const ConjuntoMonstros *c, int indice, Vector2 alvo, ObjetoLancavel *objeto)
+{
+    if (!c || indice < 0 || indice >= c->quantidade || !objeto) return;
+    const MonstroInfo *info = &gMonstrosInfo[c->tipo[indice]];
+    float dx = alvo.x - c->posX[indice];
+    float dy = alvo.y - c->posY[indice];
+    float distancia = sqrtf(dx * dx + dy * dy);
+
+    IniciarObjeto(objeto, info->tipo, info->danoObjeto, info->velocidadeObjeto);
+    objeto->posicao = (Vector2){ c->posX[indice], c->posY[indice] };
+    objeto->posicaoAnterior = objeto->posicao;
+    objeto->direcao = (Vector2){ dx / distancia, dy / distancia };
+    objeto->ativo = true;
 }
@@ -1,37 +1,19 @@
 #include "objeto.h"
 #include "jogador.h"
+#include "testes_acerto.h"
 #include <math.h>
-#include <string.h>
 
-bool IniciarObjeto(ObjetoLancavel* o, const char* caminhoSprite) {
-    if (!o) return false;
-
-    o->sprite = LoadTexture(caminhoSprite);
-    if (o->sprite.id == 0) {
-        o->ativo = false;
-        return false; 
-    }
-    if (caminhoSprite) {
-        strncpy(o->caminhoSprite, caminhoSprite, sizeof(o->caminhoSprite) - 1);
-        o->caminhoSprite[sizeof(o->caminhoSprite) - 1] = '\0';
-    } else {
-        o->caminhoSprite[0] = '\0';
-    }
+void IniciarObjeto(ObjetoLancavel* o, TipoMonstro tipo, float dano, float velocidade) {
+    if (!o) return;
 
     o->posicao = (Vector2){0, 0};
+    o->posicaoAnterior = o->posicao;
     o->direcao = (Vector2){0, 0};
-    o->ativo = false;
+    o->velocidade = velocidade;
+    o->dano = dano;
     o->tempoVida = 0.0f;
-    
-    return true;
-}
-
-void DescarregarObjeto(ObjetoLancavel* o) {
-    if (!o) return;
-    if (o->sprite.id != 0) {
-        UnloadTexture(o->sprite);
-    }
-    memset(o, 0, sizeof(*o));
+    o->tipo = tipo;
+    o->ativo = false;
 }
 
 void AtualizarObjeto(ObjetoLancavel* o, float dt) {
@@ -54,25 +36,29 @@ void AtualizarObjeto(ObjetoLancavel* o, float dt) {
 void DesenharObjeto(const ObjetoLancavel* o) {
     if (!o || !o->ativo) return;
     
+    SpriteTextura sprite = Texturas_ObterSprite(ObterSpriteObjetoMonstro(o->tipo));
+    if (sprite.textura.id == 0) return;
+
     float escala = 1.0f; 
-    DrawTextureEx(
-        o->sprite,
-        (Vector2){o->posicao.x - (o->sprite.width * escala) / 2,
-                  o->posicao.y - (o->sprite.height * escala) / 2},
-        0.0f,
+    Texturas_DesenharSprite(
+        sprite,
+        (Vector2){o->posicao.x - (sprite.origem.width * escala) / 2,
+                  o->posicao.y - (sprite.origem.height * escala) / 2},
         escala,
         WHITE);
 }
 
-bool VerificarColisaoObjetoJogador(ObjetoLancavel* o, struct Jogador* jogador) {
+bool VerificarColisaoObjetoJogador(ObjetoLancavel* o, struct Jogador* jogador, Vector2 posicaoAnteriorJogador) {
     if (!o || !o->ativo || !jogador) return false;
 
     const float raioObjeto = 10.0f; 
     const float raioJogador = 20.0f;
+    const float soma = raioObjeto + raioJogador;
 
-    float dx = o->posicao.x - jogador->posicao.x;
-    float dy = o->posicao.y - jogador->posicao.y;
-    float distancia = sqrtf(dx * dx + dy * dy);
-
-    return distancia < (raioObjeto + raioJogador);
+    // Trajeto do objeto no passo visto pelo jogador: testar só a posição final
+    // deixaria um objeto rápido (ou um passo longo) atravessar o jogador
+    Vector2 inicio = { o->posicaoAnterior.x - posicaoAnteriorJogador.x,
+                       o->posicaoAnterior.y - posicaoAnteriorJogador.y };
+    Vector2 fim = { o->posicao.x - jogador->posicao.x, o->posicao.y - jogador->posicao.y };
+    return TestesAcerto_DistanciaSegmento2(inicio, fim, (Vector2){ 0.0f, 0.0f }) < soma * soma;
 }
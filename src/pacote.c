@@ -0,0 +1,226 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "pacote.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char MAGICO_PACOTE[4] = { 'M', 'T', 'A', 'P' };
+
+typedef struct {
+    const unsigned char *dados;
+    size_t tamanho;
+    bool mapeado;           // false: bloco lido com fread, liberar com free
+    uint32_t quantidade;
+} PacoteAssets;
+
+static PacoteAssets gPacote;
+
+static uint16_t LerU16(const unsigned char *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t LerU32(const unsigned char *p)
+{
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= (uint32_t)p[i] << (8 * i);
+    return v;
+}
+
+static float LerF32(const unsigned char *p)
+{
+    uint32_t bits = LerU32(p);
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+#ifdef _WIN32
+// windows.h colide com o raylib.h; o pacote é pequeno, então uma leitura só basta
+static bool MapearArquivo(const char *caminho)
+{
+    FILE *arquivo = fopen(caminho, "rb");
+    if (!arquivo) return false;
+    fseek(arquivo, 0, SEEK_END);
+    long tamanho = ftell(arquivo);
+    fseek(arquivo, 0, SEEK_SET);
+    unsigned char *dados = (tamanho > 0) ? malloc((size_t)tamanho) : NULL;
+    if (!dados || fread(dados, 1, (size_t)tamanho, arquivo) != (size_t)tamanho) {
+        free(dados);
+        fclose(arquivo);
+        return false;
+    }
+    fclose(arquivo);
+    gPacote.dados = dados;
+    gPacote.tamanho = (size_t)tamanho;
+    gPacote.mapeado = false;
+    return true;
+}
+#else
+static bool MapearArquivo(const char *caminho)
+{
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    void *dados = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (dados == MAP_FAILED) return false;
+    gPacote.dados = dados;
+    gPacote.tamanho = (size_t)info.st_size;
+    gPacote.mapeado = true;
+    return true;
+}
+#endif
+
+static void DesmapearArquivo(void)
+{
+    if (!gPacote.dados) return;
+#ifndef _WIN32
+    if (gPacote.mapeado) {
+        munmap((void *)gPacote.dados, gPacote.tamanho);
+        return;
+    }
+#endif
+    free((void *)gPacote.dados);
+}
+
+static const unsigned char *Entrada(uint32_t indice)
+{
+    return gPacote.dados + PACOTE_TAMANHO_CABECALHO + (size_t)indice * PACOTE_TAMANHO_ENTRADA;
+}
+
+static bool ValidarPacote(void)
+{
+    if (gPacote.tamanho < PACOTE_TAMANHO_CABECALHO) return false;
+    if (memcmp(gPacote.dados, MAGICO_PACOTE, 4) != 0) return false;
+    if (LerU16(gPacote.dados + 4) != PACOTE_VERSAO) return false;
+    uint32_t quantidade = LerU32(gPacote.dados + 8);
+    size_t fimDiretorio = PACOTE_TAMANHO_CABECALHO + (size_t)quantidade * PACOTE_TAMANHO_ENTRADA;
+    if (fimDiretorio > gPacote.tamanho) return false;
+
+    for (uint32_t i = 0; i < quantidade; ++i) {
+        const unsigned char *e = Entrada(i);
+        if (memchr(e, '\0', PACOTE_TAMANHO_CAMINHO) == NULL) return false;
+        size_t offset = LerU32(e + 112);
+        size_t tamanho = LerU32(e + 116);
+        if (offset < fimDiretorio || offset + tamanho > gPacote.tamanho) return false;
+    }
+    gPacote.quantidade = quantidade;
+    return true;
+}
+
+bool Pacote_Abrir(const char *caminho)
+{
+    Pacote_Fechar();
+    if (!caminho || !MapearArquivo(caminho)) return false;
+    if (!ValidarPacote()) {
+        printf("Aviso: pacote de assets invalido ou de outra versao: %s\n", caminho);
+        Pacote_Fechar();
+        return false;
+    }
+    return true;
+}
+
+void Pacote_Fechar(void)
+{
+    DesmapearArquivo();
+    memset(&gPacote, 0, sizeof(gPacote));
+}
+
+bool Pacote_Aberto(void)
+{
+    return gPacote.dados != NULL;
+}
+
+static const unsigned char *BuscarEntrada(const char *caminho, TipoAssetPacote tipo)
+{
+    if (!gPacote.dados || !caminho) return NULL;
+    for (uint32_t i = 0; i < gPacote.quantidade; ++i) {
+        const unsigned char *e = Entrada(i);
+        if (LerU16(e + 96) == tipo && strcmp((const char *)e, caminho) == 0) return e;
+    }
+    return NULL;
+}
+
+// Imagem dos pixels de uma entrada, conferindo que cabem no tamanho declarado
+static bool ImagemDaEntrada(const unsigned char *e, Image *saida)
+{
+    int largura = (int)LerU32(e + 100);
+    int altura = (int)LerU32(e + 104);
+    int formato = (int)LerU32(e + 108);
+    if (largura <= 0 || altura <= 0) return false;
+    int bytes = GetPixelDataSize(largura, altura, formato);
+    if (bytes <= 0 || (uint32_t)bytes > LerU32(e + 116)) return false;
+
+    saida->data = (void *)(gPacote.dados + LerU32(e + 112));
+    saida->width = largura;
+    saida->height = altura;
+    saida->mipmaps = 1;
+    saida->format = formato;
+    return true;
+}
+
+bool Pacote_ObterImagem(const char *caminho, Image *saida)
+{
+    const unsigned char *e = BuscarEntrada(caminho, PACOTE_ASSET_IMAGEM);
+    if (!e || !saida) return false;
+    return ImagemDaEntrada(e, saida);
+}
+
+bool Pacote_CarregarFonte(const char *caminho, Font *saida)
+{
+    const unsigned char *e = BuscarEntrada(caminho, PACOTE_ASSET_FONTE);
+    if (!e || !saida) return false;
+
+    Image atlas;
+    if (!ImagemDaEntrada(e, &atlas)) return false;
+    int glifos = (int)LerU32(e + 124);
+    size_t bytesPixels = (size_t)GetPixelDataSize(atlas.width, atlas.height, atlas.format);
+    if (glifos <= 0 || bytesPixels + (size_t)glifos * PACOTE_TAMANHO_GLIFO > LerU32(e + 116)) return false;
+
+    Font fonte = { 0 };
+    fonte.baseSize = (int)LerU32(e + 120);
+    fonte.glyphCount = glifos;
+    fonte.glyphPadding = LerU16(e + 98);
+    // Mesmo alocador que UnloadFont usa para liberar
+    fonte.recs = RL_MALLOC((size_t)glifos * sizeof(Rectangle));
+    fonte.glyphs = RL_CALLOC((size_t)glifos, sizeof(GlyphInfo));
+    if (!fonte.recs || !fonte.glyphs) {
+        RL_FREE(fonte.recs);
+        RL_FREE(fonte.glyphs);
+        return false;
+    }
+
+    const unsigned char *g = (const unsigned char *)atlas.data + bytesPixels;
+    for (int i = 0; i < glifos; ++i, g += PACOTE_TAMANHO_GLIFO) {
+        fonte.glyphs[i].value = (int)LerU32(g);
+        fonte.glyphs[i].offsetX = (int)LerU32(g + 4);
+        fonte.glyphs[i].offsetY = (int)LerU32(g + 8);
+        fonte.glyphs[i].advanceX = (int)LerU32(g + 12);
+        fonte.recs[i] = (Rectangle){ LerF32(g + 16), LerF32(g + 20), LerF32(g + 24), LerF32(g + 28) };
+    }
+
+    fonte.texture = LoadTextureFromImage(atlas);
+    if (fonte.texture.id == 0) {
+        RL_FREE(fonte.recs);
+        RL_FREE(fonte.glyphs);
+        return false;
+    }
+    *saida = fonte;
+    return true;
+}
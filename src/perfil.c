@@ -0,0 +1,389 @@
+#ifdef MTA_PERFIL
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "perfil.h"
+#include "ui_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+// windows.h colide com o raylib.h (CloseWindow, Rectangle, DrawText...):
+// declara só as duas funções usadas, como o próprio raylib faz
+__declspec(dllimport) int __stdcall QueryPerformanceCounter(long long *contador);
+__declspec(dllimport) int __stdcall QueryPerformanceFrequency(long long *frequencia);
+
+double Perfil_Agora(void)
+{
+    static double periodo = 0.0;
+    long long agora;
+    if (periodo == 0.0) {
+        long long freq;
+        QueryPerformanceFrequency(&freq);
+        periodo = 1.0 / (double)freq;
+    }
+    QueryPerformanceCounter(&agora);
+    return (double)agora * periodo;
+}
+#else
+#include <time.h>
+double Perfil_Agora(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+#endif
+
+static const char *NOMES_ESCOPOS[PERFIL_TOTAL_ESCOPOS] = {
+    "Quadro",
+    "Simulacao",
+    "  Monstros",
+    "  Objetos lancados",
+    "  Arma secundaria",
+    "Desenho mapa",
+    "Desenho entidades",
+    "Desenho HUD",
+    "Apresentacao"
+};
+
+// Nomes sem o recuo do overlay, usados nos eventos de trace
+static const char *NOMES_TRACE[PERFIL_TOTAL_ESCOPOS] = {
+    "Quadro",
+    "Simulacao",
+    "Monstros",
+    "Objetos lancados",
+    "Arma secundaria",
+    "Desenho mapa",
+    "Desenho entidades",
+    "Desenho HUD",
+    "Apresentacao"
+};
+
+typedef enum { FASE_INTERVALO = 0, FASE_INSTANTE } FaseEvento;
+
+typedef struct {
+    const char *nome;
+    double inicio;          // segundos desde Perfil_IniciarTrace
+    double duracao;
+    int valor;
+    unsigned char fase;
+} EventoTrace;
+
+typedef struct {
+    EventoTrace *eventos;
+    int proximo;            // reservado por fetch_add; pode passar da capacidade
+    int escrevendo;         // chamadas de Registrar em andamento neste buffer
+} LadoTrace;
+
+typedef struct {
+    EventoTrace *memoria;   // os dois lados num bloco só; NULL = trace fechado
+    LadoTrace lados[2];
+    int ativo;              // lado que recebe eventos; só a thread principal troca
+    int perdidos;
+    double origem;
+    FILE *arquivo;
+    bool csv;
+    bool primeiroEvento;
+} BufferTrace;
+
+static BufferTrace gTrace;
+
+typedef struct {
+    float historico[PERFIL_QUADROS_HISTORICO][PERFIL_TOTAL_ESCOPOS];  // ms por quadro
+    int proximo;
+    int preenchidos;
+
+    double inicioQuadro;
+    double inicioEscopo[PERFIL_TOTAL_ESCOPOS];
+    double acumulado[PERFIL_TOTAL_ESCOPOS];     // segundos no quadro corrente
+    bool quadroAberto;
+    bool overlayVisivel;
+} Perfilador;
+
+static Perfilador gPerfil;
+
+void Perfil_IniciarQuadro(void)
+{
+    memset(gPerfil.acumulado, 0, sizeof(gPerfil.acumulado));
+    gPerfil.inicioQuadro = Perfil_Agora();
+    gPerfil.quadroAberto = true;
+}
+
+void Perfil_FinalizarQuadro(void)
+{
+    if (!gPerfil.quadroAberto) return;
+    gPerfil.acumulado[PERFIL_QUADRO] = Perfil_Agora() - gPerfil.inicioQuadro;
+    gPerfil.quadroAberto = false;
+
+    float *linha = gPerfil.historico[gPerfil.proximo];
+    for (int e = 0; e < PERFIL_TOTAL_ESCOPOS; ++e) {
+        linha[e] = (float)(gPerfil.acumulado[e] * 1000.0);
+    }
+    gPerfil.proximo = (gPerfil.proximo + 1) % PERFIL_QUADROS_HISTORICO;
+    if (gPerfil.preenchidos < PERFIL_QUADROS_HISTORICO) gPerfil.preenchidos++;
+
+    if (gTrace.memoria) {
+        Perfil_RegistrarIntervalo(NOMES_TRACE[PERFIL_QUADRO], gPerfil.inicioQuadro, 0);
+        const LadoTrace *lado = &gTrace.lados[gTrace.ativo];
+        if (__atomic_load_n(&lado->proximo, __ATOMIC_RELAXED) > PERFIL_CAPACIDADE_TRACE / 4 * 3) {
+            Perfil_DescarregarTrace();
+        }
+    }
+}
+
+void Perfil_IniciarEscopo(EscopoPerfil escopo)
+{
+    gPerfil.inicioEscopo[escopo] = Perfil_Agora();
+}
+
+void Perfil_FinalizarEscopo(EscopoPerfil escopo)
+{
+    double agora = Perfil_Agora();
+    gPerfil.acumulado[escopo] += agora - gPerfil.inicioEscopo[escopo];
+    if (gTrace.memoria) Perfil_RegistrarIntervalo(NOMES_TRACE[escopo], gPerfil.inicioEscopo[escopo], 0);
+}
+
+static bool TerminaCom(const char *texto, const char *sufixo)
+{
+    size_t n = strlen(texto), m = strlen(sufixo);
+    return n >= m && strcmp(texto + n - m, sufixo) == 0;
+}
+
+bool Perfil_IniciarTrace(const char *caminho)
+{
+    if (gTrace.memoria) Perfil_FinalizarTrace();
+    if (!caminho) return false;
+
+    FILE *arquivo = fopen(caminho, "w");
+    if (!arquivo) {
+        printf("Erro: nao foi possivel criar o trace %s\n", caminho);
+        return false;
+    }
+    EventoTrace *memoria = calloc(2 * (size_t)PERFIL_CAPACIDADE_TRACE, sizeof(EventoTrace));
+    if (!memoria) {
+        printf("Erro: sem memoria para o buffer de trace\n");
+        fclose(arquivo);
+        return false;
+    }
+
+    memset(&gTrace, 0, sizeof(gTrace));
+    gTrace.arquivo = arquivo;
+    gTrace.csv = TerminaCom(caminho, ".csv") || TerminaCom(caminho, ".CSV");
+    gTrace.primeiroEvento = true;
+    gTrace.origem = Perfil_Agora();
+    gTrace.lados[0].eventos = memoria;
+    gTrace.lados[1].eventos = memoria + PERFIL_CAPACIDADE_TRACE;
+    if (gTrace.csv) {
+        fprintf(arquivo, "nome,fase,inicio_us,duracao_us,valor\n");
+    } else {
+        // Formato de array: o "]" final é opcional para o chrome://tracing e
+        // o Perfetto, então o arquivo já é legível a cada descarregamento.
+        fprintf(arquivo, "[\n");
+    }
+    // Publica o bloco por último: produtores só olham `memoria`
+    __atomic_store_n(&gTrace.memoria, memoria, __ATOMIC_RELEASE);
+    return true;
+}
+
+static void Registrar(const char *nome, double inicio, double duracao, int valor, FaseEvento fase)
+{
+    LadoTrace *lado;
+    for (;;) {
+        if (!__atomic_load_n(&gTrace.memoria, __ATOMIC_ACQUIRE)) return;
+        int ativo = __atomic_load_n(&gTrace.ativo, __ATOMIC_SEQ_CST);
+        lado = &gTrace.lados[ativo];
+        __atomic_fetch_add(&lado->escrevendo, 1, __ATOMIC_SEQ_CST);
+        // Confere de novo depois de se anunciar: quem descarrega troca `ativo`
+        // (ou fecha `memoria`) e só então olha `escrevendo`, então ou este
+        // registro vê a troca e tenta o outro lado, ou o descarregamento o espera
+        if (__atomic_load_n(&gTrace.ativo, __ATOMIC_SEQ_CST) == ativo &&
+            __atomic_load_n(&gTrace.memoria, __ATOMIC_SEQ_CST)) {
+            break;
+        }
+        __atomic_fetch_sub(&lado->escrevendo, 1, __ATOMIC_RELEASE);
+    }
+
+    int indice = __atomic_fetch_add(&lado->proximo, 1, __ATOMIC_RELAXED);
+    if (indice < PERFIL_CAPACIDADE_TRACE) {
+        EventoTrace *ev = &lado->eventos[indice];
+        ev->nome = nome;
+        ev->inicio = inicio - gTrace.origem;
+        ev->duracao = duracao;
+        ev->valor = valor;
+        ev->fase = (unsigned char)fase;
+    } else {
+        __atomic_fetch_add(&gTrace.perdidos, 1, __ATOMIC_RELAXED);
+    }
+    __atomic_fetch_sub(&lado->escrevendo, 1, __ATOMIC_RELEASE);
+}
+
+void Perfil_RegistrarEvento(const char *nome, int valor)
+{
+    Registrar(nome, Perfil_Agora(), 0.0, valor, FASE_INSTANTE);
+}
+
+void Perfil_RegistrarIntervalo(const char *nome, double inicio, int valor)
+{
+    Registrar(nome, inicio, Perfil_Agora() - inicio, valor, FASE_INTERVALO);
+}
+
+static void EscreverEvento(const EventoTrace *ev)
+{
+    FILE *f = gTrace.arquivo;
+    double inicioUs = ev->inicio * 1e6;
+    double duracaoUs = ev->duracao * 1e6;
+    if (gTrace.csv) {
+        fprintf(f, "%s,%s,%.3f,%.3f,%d\n", ev->nome,
+                ev->fase == FASE_INSTANTE ? "instante" : "intervalo",
+                inicioUs, duracaoUs, ev->valor);
+        return;
+    }
+    fprintf(f, "%s", gTrace.primeiroEvento ? "" : ",\n");
+    gTrace.primeiroEvento = false;
+    if (ev->fase == FASE_INSTANTE) {
+        fprintf(f, "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":1,\"tid\":1,"
+                   "\"args\":{\"valor\":%d}}",
+                ev->nome, inicioUs, ev->valor);
+    } else {
+        fprintf(f, "{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1}",
+                ev->nome, inicioUs, duracaoUs);
+    }
+}
+
+// Espera os registros em andamento no lado terminarem, escreve os eventos e o
+// esvazia. O lado já não pode receber registros novos.
+static void EscreverLado(LadoTrace *lado)
+{
+    while (__atomic_load_n(&lado->escrevendo, __ATOMIC_SEQ_CST) > 0) {
+        // registros levam poucas instruções
+    }
+    int quantidade = __atomic_load_n(&lado->proximo, __ATOMIC_ACQUIRE);
+    if (quantidade > PERFIL_CAPACIDADE_TRACE) quantidade = PERFIL_CAPACIDADE_TRACE;
+    for (int i = 0; i < quantidade; ++i) {
+        EscreverEvento(&lado->eventos[i]);
+    }
+    __atomic_store_n(&lado->proximo, 0, __ATOMIC_RELAXED);
+}
+
+void Perfil_DescarregarTrace(void)
+{
+    if (!gTrace.memoria) return;
+    int anterior = gTrace.ativo;
+    __atomic_store_n(&gTrace.ativo, 1 - anterior, __ATOMIC_SEQ_CST);
+    EscreverLado(&gTrace.lados[anterior]);
+    fflush(gTrace.arquivo);
+}
+
+void Perfil_FinalizarTrace(void)
+{
+    if (!gTrace.memoria) return;
+    Perfil_DescarregarTrace();
+    // Fecha a entrada; quem já tinha passado da conferência termina no lado ativo
+    EventoTrace *memoria = gTrace.memoria;
+    __atomic_store_n(&gTrace.memoria, NULL, __ATOMIC_SEQ_CST);
+    EscreverLado(&gTrace.lados[gTrace.ativo]);
+    if (!gTrace.csv) fprintf(gTrace.arquivo, "\n]\n");
+    fclose(gTrace.arquivo);
+    if (gTrace.perdidos > 0) {
+        printf("Aviso: %d eventos de trace descartados (buffer cheio)\n", gTrace.perdidos);
+    }
+    free(memoria);
+    memset(&gTrace, 0, sizeof(gTrace));
+}
+
+static int CompararFloat(const void *a, const void *b)
+{
+    float fa = *(const float *)a;
+    float fb = *(const float *)b;
+    return (fa > fb) - (fa < fb);
+}
+
+EstatisticasPerfil Perfil_Estatisticas(EscopoPerfil escopo)
+{
+    EstatisticasPerfil est = {0};
+    int n = gPerfil.preenchidos;
+    if (n == 0) return est;
+
+    float amostras[PERFIL_QUADROS_HISTORICO];
+    double soma = 0.0;
+    for (int i = 0; i < n; ++i) {
+        amostras[i] = gPerfil.historico[i][escopo];
+        soma += amostras[i];
+    }
+    qsort(amostras, (size_t)n, sizeof(float), CompararFloat);
+
+    int ultimo = (gPerfil.proximo + PERFIL_QUADROS_HISTORICO - 1) % PERFIL_QUADROS_HISTORICO;
+    int indiceP99 = (int)((n - 1) * 0.99f + 0.5f);
+    est.ultimo = gPerfil.historico[ultimo][escopo];
+    est.minimo = amostras[0];
+    est.media = (float)(soma / n);
+    est.p99 = amostras[indiceP99];
+    return est;
+}
+
+void Perfil_AlternarOverlay(void)
+{
+    gPerfil.overlayVisivel = !gPerfil.overlayVisivel;
+}
+
+static void DesenharGraficoQuadros(Rectangle area)
+{
+    const float alvo60 = 1000.0f / 60.0f;
+    float maximo = alvo60 * 2.0f;
+    for (int i = 0; i < gPerfil.preenchidos; ++i) {
+        if (gPerfil.historico[i][PERFIL_QUADRO] > maximo) maximo = gPerfil.historico[i][PERFIL_QUADRO];
+    }
+
+    DrawRectangleRec(area, ColorAlpha(BLACK, 0.5f));
+    float larguraBarra = area.width / PERFIL_QUADROS_HISTORICO;
+    int inicio = (gPerfil.preenchidos < PERFIL_QUADROS_HISTORICO) ? 0 : gPerfil.proximo;
+    for (int k = 0; k < gPerfil.preenchidos; ++k) {
+        float ms = gPerfil.historico[(inicio + k) % PERFIL_QUADROS_HISTORICO][PERFIL_QUADRO];
+        float h = area.height * (ms / maximo);
+        Color cor = (ms <= alvo60 * 1.05f) ? GREEN : (ms <= alvo60 * 2.0f) ? YELLOW : RED;
+        DrawRectangleRec((Rectangle){ area.x + k * larguraBarra, area.y + area.height - h,
+                                      larguraBarra > 1.0f ? larguraBarra : 1.0f, h }, cor);
+    }
+    float yAlvo = area.y + area.height - area.height * (alvo60 / maximo);
+    DrawLineV((Vector2){ area.x, yAlvo }, (Vector2){ area.x + area.width, yAlvo }, ColorAlpha(WHITE, 0.6f));
+}
+
+void Perfil_DesenharOverlay(Font fonte, int largura, int altura)
+{
+    (void)altura;
+    if (!gPerfil.overlayVisivel) return;
+
+    const float escala = UI_GetEscala();
+    const float tamFonte = UI_AjustarTamanhoFonte(16.0f);
+    const float linhaAlt = tamFonte + 2.0f;
+    const float margem = 10.0f * escala;
+    const float larguraPainel = 430.0f * escala;
+    const float alturaGrafico = 70.0f * escala;
+    const float alturaPainel = margem * 3.0f + linhaAlt * (PERFIL_TOTAL_ESCOPOS + 1) + alturaGrafico;
+    Rectangle painel = { largura - larguraPainel - margem, margem, larguraPainel, alturaPainel };
+    DrawRectangleRec(painel, ColorAlpha((Color){12, 12, 26, 255}, 0.85f));
+
+    const float colNome = painel.x + margem;
+    const float colValores = painel.x + larguraPainel * 0.45f;
+    float y = painel.y + margem;
+    DrawTextEx(fonte, "Escopo", (Vector2){ colNome, y }, tamFonte, 1.0f, GRAY);
+    DrawTextEx(fonte, " ultimo    min    med    p99 (ms)", (Vector2){ colValores, y }, tamFonte, 1.0f, GRAY);
+    y += linhaAlt;
+
+    for (int e = 0; e < PERFIL_TOTAL_ESCOPOS; ++e) {
+        EstatisticasPerfil est = Perfil_Estatisticas((EscopoPerfil)e);
+        Color cor = (e == PERFIL_QUADRO) ? GOLD : WHITE;
+        DrawTextEx(fonte, NOMES_ESCOPOS[e], (Vector2){ colNome, y }, tamFonte, 1.0f, cor);
+        DrawTextEx(fonte, TextFormat("%7.2f %6.2f %6.2f %6.2f", est.ultimo, est.minimo, est.media, est.p99),
+                   (Vector2){ colValores, y }, tamFonte, 1.0f, cor);
+        y += linhaAlt;
+    }
+
+    DesenharGraficoQuadros((Rectangle){ colNome, y + margem, larguraPainel - margem * 2.0f, alturaGrafico });
+}
+
+#endif
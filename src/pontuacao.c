@@ -20,20 +20,21 @@ void PontuacaoInicializar(EstadoPontuacao *estado)
     memset(estado, 0, sizeof(*estado));
 }
 
-void PontuacaoPrepararCadastro(EstadoPontuacao *estado, int pontuacao)
+void PontuacaoPrepararCadastro(EstadoPontuacao *estado, int pontuacao, uint64_t semente)
 {
     if (!estado) return;
     estado->cadastro.pontuacaoFinal = pontuacao;
+    estado->cadastro.semente = semente;
     estado->cadastro.nome[0] = '\0';
     estado->cadastro.tamanho = 0;
 }
 
-void PontuacaoRecarregarArquivo(EstadoPontuacao *estado)
+bool PontuacaoCarregarArquivo(LeaderboardDados *dados, const char *caminho)
 {
-    if (!estado) return;
-    estado->leaderboard.quantidade = 0;
-    FILE *arquivo = fopen(ARQUIVO_PONTUACOES, "r");
-    if (!arquivo) return;
+    if (!dados || !caminho) return false;
+    dados->quantidade = 0;
+    FILE *arquivo = fopen(caminho, "r");
+    if (!arquivo) return false;
 
     char linha[256];
     while (fgets(linha, sizeof(linha), arquivo)) {
@@ -53,17 +54,24 @@ void PontuacaoRecarregarArquivo(EstadoPontuacao *estado)
         EntradaLeaderboard entrada = {0};
         strncpy(entrada.nome, nome, sizeof(entrada.nome) - 1);
         entrada.pontuacao = atoi(pontStr);
-        estado->leaderboard.entradas[estado->leaderboard.quantidade++] = entrada;
-        if (estado->leaderboard.quantidade >= MAX_ENTRADAS_LEADERBOARD) break;
+        dados->entradas[dados->quantidade++] = entrada;
+        if (dados->quantidade >= MAX_ENTRADAS_LEADERBOARD) break;
     }
     fclose(arquivo);
 
-    if (estado->leaderboard.quantidade > 1) {
-        qsort(estado->leaderboard.entradas,
-              estado->leaderboard.quantidade,
+    if (dados->quantidade > 1) {
+        qsort(dados->entradas,
+              dados->quantidade,
               sizeof(EntradaLeaderboard),
               CompararPontuacao);
     }
+    return true;
+}
+
+void PontuacaoRecarregarArquivo(EstadoPontuacao *estado)
+{
+    if (!estado) return;
+    PontuacaoCarregarArquivo(&estado->leaderboard, ARQUIVO_PONTUACOES);
 }
 
 static bool SalvarPontuacaoEmArquivo(const CadastroPontuacao *cadastro)
@@ -152,6 +160,13 @@ ResultadoTelaPontuacao PontuacaoDesenharTelaCadastro(EstadoPontuacao *estado,
                (Vector2){ largura / 2.0f - medidaTitulo.x / 2.0f, altura * 0.25f },
                tituloTam, 1.0f, WHITE);
 
+    const char *textoSemente = TextFormat("Semente: %llu", (unsigned long long)cadastro->semente);
+    float sementeTam = UI_AjustarTamanhoFonte(20.0f);
+    Vector2 medidaSemente = MeasureTextEx(fonteBold, textoSemente, sementeTam, 1.0f);
+    DrawTextEx(fonteBold, textoSemente,
+               (Vector2){ largura / 2.0f - medidaSemente.x / 2.0f, altura * 0.25f + tituloTam + 8.0f },
+               sementeTam, 1.0f, GRAY);
+
     const char *instrucao = "Digite seu nome:";
     float instrTam = UI_AjustarTamanhoFonte(28.0f);
     Vector2 medidaInstrucao = MeasureTextEx(fonteBold, instrucao, instrTam, 1.0f);
@@ -0,0 +1,92 @@
+#include "projeteis.h"
+
+void Projeteis_Limpar(ConjuntoProjeteis *p)
+{
+    if (!p) return;
+    for (int i = 0; i < p->limite; ++i) {
+        p->ativo[i] = false;
+        p->arma[i] = NULL;
+    }
+    p->quantidade = 0;
+    p->limite = 0;
+    p->quantidadeLivres = 0;
+}
+
+int Projeteis_Disparar(ConjuntoProjeteis *p, const ArmaPrincipal *arma, Vector2 origem,
+                       Vector2 velocidade, float duracao)
+{
+    if (!p) return -1;
+    int indice;
+    if (p->quantidadeLivres > 0) {
+        indice = p->livres[--p->quantidadeLivres];
+    } else if (p->limite < MAX_PROJETEIS) {
+        indice = p->limite++;
+    } else {
+        return -1;
+    }
+
+    p->ativo[indice] = true;
+    p->posX[indice] = origem.x;
+    p->posY[indice] = origem.y;
+    p->posXAnterior[indice] = origem.x;
+    p->posYAnterior[indice] = origem.y;
+    p->velX[indice] = velocidade.x;
+    p->velY[indice] = velocidade.y;
+    p->tempoRestante[indice] = duracao;
+    p->arma[indice] = arma;
+    p->quantidade++;
+    return indice;
+}
+
+void Projeteis_Remover(ConjuntoProjeteis *p, int indice)
+{
+    if (!p || indice < 0 || indice >= p->limite || !p->ativo[indice]) return;
+    p->ativo[indice] = false;
+    p->arma[indice] = NULL;
+    p->quantidade--;
+    if (p->quantidade == 0) {
+        // Sem ninguém em voo a pilha recomeça do slot 0 e os laços encolhem
+        p->limite = 0;
+        p->quantidadeLivres = 0;
+        return;
+    }
+    p->livres[p->quantidadeLivres++] = indice;
+}
+
+void Projeteis_ArmazenarPosicoesAnteriores(ConjuntoProjeteis *p)
+{
+    if (!p) return;
+    for (int i = 0; i < p->limite; ++i) {
+        p->posXAnterior[i] = p->posX[i];
+        p->posYAnterior[i] = p->posY[i];
+    }
+}
+
+void Projeteis_Mover(ConjuntoProjeteis *p, float dt)
+{
+    if (!p) return;
+    // Slots inativos também andam: custa menos que desviar e ninguém os lê
+    for (int i = 0; i < p->limite; ++i) {
+        p->posX[i] += p->velX[i] * dt;
+        p->posY[i] += p->velY[i] * dt;
+        p->tempoRestante[i] -= dt;
+    }
+}
+
+void Projeteis_Desenhar(const ConjuntoProjeteis *p, float alfa)
+{
+    if (!p) return;
+    for (int i = 0; i < p->limite; ++i) {
+        if (!p->ativo[i]) continue;
+        const ArmaPrincipal *arma = p->arma[i];
+        float raioVisual = (arma && arma->raioProjetilVisual > 0.0f)
+                           ? arma->raioProjetilVisual
+                           : 6.0f;
+        Color cor = (arma && arma->corProjetil.a != 0) ? arma->corProjetil : SKYBLUE;
+        Vector2 posicao = {
+            p->posXAnterior[i] + (p->posX[i] - p->posXAnterior[i]) * alfa,
+            p->posYAnterior[i] + (p->posY[i] - p->posYAnterior[i]) * alfa
+        };
+        DrawCircleV(posicao, raioVisual, cor);
+    }
+}
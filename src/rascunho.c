@@ -0,0 +1,40 @@
+#include "rascunho.h"
+
+static Arena gRascunho = {0};
+
+bool Rascunho_Inicializar(size_t capacidade)
+{
+    Arena_Liberar(&gRascunho);
+    return Arena_Inicializar(&gRascunho, capacidade);
+}
+
+void Rascunho_Finalizar(void)
+{
+    Arena_Liberar(&gRascunho);
+}
+
+void Rascunho_NovoQuadro(void)
+{
+    Arena_Resetar(&gRascunho);
+}
+
+size_t Rascunho_Marca(void)
+{
+    return Arena_Marca(&gRascunho);
+}
+
+void Rascunho_Voltar(size_t marca)
+{
+    Arena_Voltar(&gRascunho, marca);
+}
+
+void *Rascunho_Alocar(size_t tamanho)
+{
+    if (!gRascunho.base && !Rascunho_Inicializar(RASCUNHO_CAPACIDADE_PADRAO)) return NULL;
+    return Arena_Alocar(&gRascunho, tamanho);
+}
+
+const Arena *Rascunho_Estatisticas(void)
+{
+    return &gRascunho;
+}
@@ -0,0 +1,410 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "regioes_mapa.h"
+#include "perfil.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TAMANHO_CABECALHO 32
+#define TILES_REGIAO (REGIAO_TILES * REGIAO_TILES)
+#define BYTES_COLISAO_REGIAO (TILES_REGIAO / 8)
+#define BYTES_REGIAO (TILES_REGIAO + BYTES_COLISAO_REGIAO)
+#define LADO_DESCARTE (2 * REGIOES_RAIO_DESCARTE + 1)
+// Folga para pedidos ainda em leitura quando o jogador já se afastou deles
+#define TOTAL_SLOTS (2 * LADO_DESCARTE * LADO_DESCARTE)
+
+static const char MAGICO_MAPA[4] = { 'M', 'T', 'A', 'M' };
+
+typedef enum {
+    REGIAO_LIVRE = 0,
+    REGIAO_PEDIDA,      // na fila ou sendo lida: só a thread de leitura toca
+    REGIAO_PRONTA
+} EstadoRegiao;
+
+typedef struct {
+    int regiao;         // índice da região no arquivo; -1 com o slot livre
+    int estado;         // EstadoRegiao, publicado com release pela leitura
+    uint8_t ids[TILES_REGIAO];
+    uint8_t colisao[BYTES_COLISAO_REGIAO];
+} SlotRegiao;
+
+struct RegioesMapa {
+    FILE *arquivo;                  // só a thread de leitura usa depois de aberto
+    int linhas;
+    int colunas;
+    int regioesLinhas;
+    int regioesColunas;
+    int16_t *slotDaRegiao;          // -1 = não residente; só a thread principal acessa
+    SlotRegiao slots[TOTAL_SLOTS];
+
+    pthread_t thread;
+    pthread_mutex_t trava;
+    pthread_cond_t temPedido;
+    pthread_cond_t carregou;
+    int fila[TOTAL_SLOTS];          // slots PEDIDA em ordem de pedido
+    int inicioFila;
+    int tamanhoFila;
+    int pendentes;
+    bool encerrar;
+    int regiaoLinha;                // região da última atualização; -1 = nenhuma
+    int regiaoColuna;
+};
+
+static void EscreverU16(unsigned char *p, uint16_t v)
+{
+    p[0] = (unsigned char)(v & 0xFF);
+    p[1] = (unsigned char)(v >> 8);
+}
+
+static void EscreverU32(unsigned char *p, uint32_t v)
+{
+    for (int i = 0; i < 4; ++i) p[i] = (unsigned char)(v >> (8 * i));
+}
+
+static uint16_t LerU16(const unsigned char *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t LerU32(const unsigned char *p)
+{
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= (uint32_t)p[i] << (8 * i);
+    return v;
+}
+
+static int DividirParaCima(int a, int b)
+{
+    return (a + b - 1) / b;
+}
+
+bool RegioesMapa_Gravar(const char *caminho, int linhas, int colunas, GeradorTileMapa gerador)
+{
+    if (!caminho || !gerador || linhas <= 0 || colunas <= 0) return false;
+    FILE *arquivo = fopen(caminho, "wb");
+    if (!arquivo) return false;
+
+    unsigned char cabecalho[TAMANHO_CABECALHO] = { 0 };
+    memcpy(cabecalho, MAGICO_MAPA, 4);
+    EscreverU16(cabecalho + 4, REGIOES_MAPA_VERSAO);
+    EscreverU16(cabecalho + 6, REGIAO_TILES);
+    EscreverU32(cabecalho + 8, (uint32_t)linhas);
+    EscreverU32(cabecalho + 12, (uint32_t)colunas);
+    bool sucesso = fwrite(cabecalho, 1, sizeof(cabecalho), arquivo) == sizeof(cabecalho);
+
+    unsigned char regiao[BYTES_REGIAO];
+    const int regioesLinhas = DividirParaCima(linhas, REGIAO_TILES);
+    const int regioesColunas = DividirParaCima(colunas, REGIAO_TILES);
+    for (int rl = 0; rl < regioesLinhas && sucesso; ++rl) {
+        for (int rc = 0; rc < regioesColunas && sucesso; ++rc) {
+            memset(regiao, 0, TILES_REGIAO);
+            memset(regiao + TILES_REGIAO, 0xFF, BYTES_COLISAO_REGIAO);
+            for (int li = 0; li < REGIAO_TILES; ++li) {
+                int i = rl * REGIAO_TILES + li;
+                if (i >= linhas) break;
+                for (int lj = 0; lj < REGIAO_TILES; ++lj) {
+                    int j = rc * REGIAO_TILES + lj;
+                    if (j >= colunas) break;
+                    int local = li * REGIAO_TILES + lj;
+                    bool colisao = false;
+                    regiao[local] = gerador(i, j, linhas, colunas, &colisao);
+                    if (!colisao) regiao[TILES_REGIAO + (local >> 3)] &= (unsigned char)~(1u << (local & 7));
+                }
+            }
+            sucesso = fwrite(regiao, 1, BYTES_REGIAO, arquivo) == BYTES_REGIAO;
+        }
+    }
+    if (fclose(arquivo) != 0) sucesso = false;
+    if (sucesso) {
+        printf("%s: mapa %dx%d em %d regioes\n", caminho, linhas, colunas, regioesLinhas * regioesColunas);
+    }
+    return sucesso;
+}
+
+static void LerRegiao(RegioesMapa *regioes, SlotRegiao *slot)
+{
+    double inicio = PERFIL_AGORA();
+    long offset = TAMANHO_CABECALHO + (long)slot->regiao * BYTES_REGIAO;
+    if (fseek(regioes->arquivo, offset, SEEK_SET) != 0 ||
+        fread(slot->ids, 1, TILES_REGIAO, regioes->arquivo) != TILES_REGIAO ||
+        fread(slot->colisao, 1, BYTES_COLISAO_REGIAO, regioes->arquivo) != BYTES_COLISAO_REGIAO) {
+        printf("Aviso: falha ao ler a regiao %d do mapa\n", slot->regiao);
+        memset(slot->ids, 0, sizeof(slot->ids));
+        memset(slot->colisao, 0xFF, sizeof(slot->colisao));
+    }
+    PERFIL_INTERVALO("Carregar regiao", inicio, slot->regiao);
+}
+
+static void *ExecutarLeitura(void *arg)
+{
+    RegioesMapa *regioes = (RegioesMapa *)arg;
+    pthread_mutex_lock(&regioes->trava);
+    for (;;) {
+        while (regioes->tamanhoFila == 0 && !regioes->encerrar) {
+            pthread_cond_wait(&regioes->temPedido, &regioes->trava);
+        }
+        if (regioes->encerrar) break;
+        SlotRegiao *slot = &regioes->slots[regioes->fila[regioes->inicioFila]];
+        regioes->inicioFila = (regioes->inicioFila + 1) % TOTAL_SLOTS;
+        regioes->tamanhoFila--;
+        pthread_mutex_unlock(&regioes->trava);
+
+        LerRegiao(regioes, slot);
+        __atomic_store_n(&slot->estado, REGIAO_PRONTA, __ATOMIC_RELEASE);
+
+        pthread_mutex_lock(&regioes->trava);
+        regioes->pendentes--;
+        pthread_cond_broadcast(&regioes->carregou);
+    }
+    pthread_mutex_unlock(&regioes->trava);
+    return NULL;
+}
+
+static bool LerCabecalho(RegioesMapa *regioes)
+{
+    unsigned char cabecalho[TAMANHO_CABECALHO];
+    if (fread(cabecalho, 1, sizeof(cabecalho), regioes->arquivo) != sizeof(cabecalho)) return false;
+    if (memcmp(cabecalho, MAGICO_MAPA, 4) != 0) return false;
+    if (LerU16(cabecalho + 4) != REGIOES_MAPA_VERSAO || LerU16(cabecalho + 6) != REGIAO_TILES) return false;
+    uint32_t linhas = LerU32(cabecalho + 8);
+    uint32_t colunas = LerU32(cabecalho + 12);
+    if (linhas == 0 || colunas == 0 || linhas > INT16_MAX * REGIAO_TILES || colunas > INT16_MAX * REGIAO_TILES) {
+        return false;
+    }
+    regioes->linhas = (int)linhas;
+    regioes->colunas = (int)colunas;
+    regioes->regioesLinhas = DividirParaCima(regioes->linhas, REGIAO_TILES);
+    regioes->regioesColunas = DividirParaCima(regioes->colunas, REGIAO_TILES);
+
+    // O arquivo precisa ter todas as regiões; offsets ficam em long
+    double esperado = TAMANHO_CABECALHO +
+                      (double)regioes->regioesLinhas * regioes->regioesColunas * BYTES_REGIAO;
+    if (esperado > 2147483647.0 || fseek(regioes->arquivo, 0, SEEK_END) != 0) return false;
+    return ftell(regioes->arquivo) >= (long)esperado;
+}
+
+RegioesMapa *RegioesMapa_Abrir(const char *caminho, int *linhas, int *colunas)
+{
+    if (!caminho) return NULL;
+    RegioesMapa *regioes = (RegioesMapa *)calloc(1, sizeof(RegioesMapa));
+    if (!regioes) return NULL;
+
+    regioes->arquivo = fopen(caminho, "rb");
+    if (!regioes->arquivo) {
+        printf("Erro: nao foi possivel abrir o mapa %s\n", caminho);
+        free(regioes);
+        return NULL;
+    }
+    if (!LerCabecalho(regioes)) {
+        printf("Erro: mapa invalido, incompleto ou de outra versao: %s\n", caminho);
+        fclose(regioes->arquivo);
+        free(regioes);
+        return NULL;
+    }
+
+    size_t totalRegioes = (size_t)regioes->regioesLinhas * regioes->regioesColunas;
+    regioes->slotDaRegiao = (int16_t *)malloc(totalRegioes * sizeof(int16_t));
+    if (!regioes->slotDaRegiao) {
+        fclose(regioes->arquivo);
+        free(regioes);
+        return NULL;
+    }
+    for (size_t r = 0; r < totalRegioes; ++r) regioes->slotDaRegiao[r] = -1;
+    regioes->regiaoLinha = -1;
+    regioes->regiaoColuna = -1;
+    for (int s = 0; s < TOTAL_SLOTS; ++s) regioes->slots[s].regiao = -1;
+
+    pthread_mutex_init(&regioes->trava, NULL);
+    pthread_cond_init(&regioes->temPedido, NULL);
+    pthread_cond_init(&regioes->carregou, NULL);
+    if (pthread_create(&regioes->thread, NULL, ExecutarLeitura, regioes) != 0) {
+        printf("Erro: nao foi possivel iniciar a leitura de regioes do mapa\n");
+        pthread_cond_destroy(&regioes->carregou);
+        pthread_cond_destroy(&regioes->temPedido);
+        pthread_mutex_destroy(&regioes->trava);
+        free(regioes->slotDaRegiao);
+        fclose(regioes->arquivo);
+        free(regioes);
+        return NULL;
+    }
+
+    if (linhas) *linhas = regioes->linhas;
+    if (colunas) *colunas = regioes->colunas;
+    return regioes;
+}
+
+void RegioesMapa_Fechar(RegioesMapa *regioes)
+{
+    if (!regioes) return;
+    pthread_mutex_lock(&regioes->trava);
+    regioes->encerrar = true;
+    pthread_cond_signal(&regioes->temPedido);
+    pthread_mutex_unlock(&regioes->trava);
+    pthread_join(regioes->thread, NULL);
+
+    pthread_cond_destroy(&regioes->carregou);
+    pthread_cond_destroy(&regioes->temPedido);
+    pthread_mutex_destroy(&regioes->trava);
+    free(regioes->slotDaRegiao);
+    fclose(regioes->arquivo);
+    free(regioes);
+}
+
+static int DistanciaRegioes(const RegioesMapa *regioes, int regiao, int rl, int rc)
+{
+    int dl = abs(regiao / regioes->regioesColunas - rl);
+    int dc = abs(regiao % regioes->regioesColunas - rc);
+    return dl > dc ? dl : dc;
+}
+
+// Libera os slots prontos fora do raio de descarte; os ainda em leitura ficam
+// para a próxima atualização
+static void DescartarDistantes(RegioesMapa *regioes, int rl, int rc)
+{
+    for (int s = 0; s < TOTAL_SLOTS; ++s) {
+        SlotRegiao *slot = &regioes->slots[s];
+        if (slot->regiao < 0) continue;
+        if (__atomic_load_n(&slot->estado, __ATOMIC_ACQUIRE) != REGIAO_PRONTA) continue;
+        if (DistanciaRegioes(regioes, slot->regiao, rl, rc) <= REGIOES_RAIO_DESCARTE) continue;
+        regioes->slotDaRegiao[slot->regiao] = -1;
+        slot->regiao = -1;
+        __atomic_store_n(&slot->estado, REGIAO_LIVRE, __ATOMIC_RELAXED);
+    }
+}
+
+// Retorna o slot da região (já residente ou recém-pedido) ou -1 sem slot livre
+static int PedirRegiao(RegioesMapa *regioes, int rl, int rc)
+{
+    int regiao = rl * regioes->regioesColunas + rc;
+    if (regioes->slotDaRegiao[regiao] >= 0) return regioes->slotDaRegiao[regiao];
+
+    int s = 0;
+    while (s < TOTAL_SLOTS && regioes->slots[s].regiao >= 0) ++s;
+    if (s == TOTAL_SLOTS) return -1;
+
+    SlotRegiao *slot = &regioes->slots[s];
+    slot->regiao = regiao;
+    __atomic_store_n(&slot->estado, REGIAO_PEDIDA, __ATOMIC_RELAXED);
+    regioes->slotDaRegiao[regiao] = (int16_t)s;
+
+    pthread_mutex_lock(&regioes->trava);
+    regioes->fila[(regioes->inicioFila + regioes->tamanhoFila) % TOTAL_SLOTS] = s;
+    regioes->tamanhoFila++;
+    regioes->pendentes++;
+    pthread_cond_signal(&regioes->temPedido);
+    pthread_mutex_unlock(&regioes->trava);
+    return s;
+}
+
+static int LimitarInt(int valor, int minimo, int maximo)
+{
+    if (valor < minimo) return minimo;
+    if (valor > maximo) return maximo;
+    return valor;
+}
+
+// Sem slot livre (muitos pedidos antigos ainda em leitura) espera uma leitura
+// terminar e tenta de novo
+static int PedirRegiaoObrigatoria(RegioesMapa *regioes, int l, int c, int rl, int rc)
+{
+    int s;
+    while ((s = PedirRegiao(regioes, l, c)) < 0) {
+        pthread_mutex_lock(&regioes->trava);
+        if (regioes->pendentes > 0) pthread_cond_wait(&regioes->carregou, &regioes->trava);
+        pthread_mutex_unlock(&regioes->trava);
+        DescartarDistantes(regioes, rl, rc);
+    }
+    return s;
+}
+
+static void EsperarRegiao(RegioesMapa *regioes, const SlotRegiao *slot)
+{
+    if (__atomic_load_n(&slot->estado, __ATOMIC_ACQUIRE) == REGIAO_PRONTA) return;
+    pthread_mutex_lock(&regioes->trava);
+    while (__atomic_load_n(&slot->estado, __ATOMIC_ACQUIRE) != REGIAO_PRONTA) {
+        pthread_cond_wait(&regioes->carregou, &regioes->trava);
+    }
+    pthread_mutex_unlock(&regioes->trava);
+}
+
+void RegioesMapa_Atualizar(RegioesMapa *regioes, int linha, int coluna)
+{
+    if (!regioes) return;
+    const int rl = LimitarInt(linha, 0, regioes->linhas - 1) / REGIAO_TILES;
+    const int rc = LimitarInt(coluna, 0, regioes->colunas - 1) / REGIAO_TILES;
+
+    DescartarDistantes(regioes, rl, rc);
+
+    // Fila em anéis a partir da região do jogador: as do raio de carga vão
+    // antes das só antecipadas
+    int slotsCarga[(2 * REGIOES_RAIO_CARGA + 1) * (2 * REGIOES_RAIO_CARGA + 1)];
+    int quantidadeCarga = 0;
+    for (int raio = 0; raio <= REGIOES_RAIO_ANTECIPACAO; ++raio) {
+        for (int dl = -raio; dl <= raio; ++dl) {
+            for (int dc = -raio; dc <= raio; ++dc) {
+                if (abs(dl) != raio && abs(dc) != raio) continue;
+                int l = rl + dl, c = rc + dc;
+                if (l < 0 || c < 0 || l >= regioes->regioesLinhas || c >= regioes->regioesColunas) continue;
+                if (raio <= REGIOES_RAIO_CARGA) {
+                    slotsCarga[quantidadeCarga++] = PedirRegiaoObrigatoria(regioes, l, c, rl, rc);
+                } else {
+                    PedirRegiao(regioes, l, c);
+                }
+            }
+        }
+    }
+
+    for (int k = 0; k < quantidadeCarga; ++k) {
+        EsperarRegiao(regioes, &regioes->slots[slotsCarga[k]]);
+    }
+    regioes->regiaoLinha = rl;
+    regioes->regiaoColuna = rc;
+}
+
+bool RegioesMapa_AreaResidente(const RegioesMapa *regioes, int *linha, int *coluna,
+                               int *linhas, int *colunas)
+{
+    if (!regioes || regioes->regiaoLinha < 0) return false;
+    int inicioLinha = (regioes->regiaoLinha - REGIOES_RAIO_CARGA) * REGIAO_TILES;
+    int inicioColuna = (regioes->regiaoColuna - REGIOES_RAIO_CARGA) * REGIAO_TILES;
+    int fimLinha = (regioes->regiaoLinha + REGIOES_RAIO_CARGA + 1) * REGIAO_TILES;
+    int fimColuna = (regioes->regiaoColuna + REGIOES_RAIO_CARGA + 1) * REGIAO_TILES;
+    inicioLinha = LimitarInt(inicioLinha, 0, regioes->linhas);
+    inicioColuna = LimitarInt(inicioColuna, 0, regioes->colunas);
+    fimLinha = LimitarInt(fimLinha, 0, regioes->linhas);
+    fimColuna = LimitarInt(fimColuna, 0, regioes->colunas);
+    *linha = inicioLinha;
+    *coluna = inicioColuna;
+    *linhas = fimLinha - inicioLinha;
+    *colunas = fimColuna - inicioColuna;
+    return true;
+}
+
+static const SlotRegiao *SlotResidente(const RegioesMapa *regioes, int i, int j, int *local)
+{
+    if (!regioes || i < 0 || j < 0 || i >= regioes->linhas || j >= regioes->colunas) return NULL;
+    int s = regioes->slotDaRegiao[(i / REGIAO_TILES) * regioes->regioesColunas + j / REGIAO_TILES];
+    if (s < 0) return NULL;
+    const SlotRegiao *slot = &regioes->slots[s];
+    if (__atomic_load_n(&slot->estado, __ATOMIC_ACQUIRE) != REGIAO_PRONTA) return NULL;
+    *local = (i % REGIAO_TILES) * REGIAO_TILES + j % REGIAO_TILES;
+    return slot;
+}
+
+int RegioesMapa_IdTile(const RegioesMapa *regioes, int i, int j)
+{
+    int local;
+    const SlotRegiao *slot = SlotResidente(regioes, i, j, &local);
+    return slot ? slot->ids[local] : -1;
+}
+
+bool RegioesMapa_Colisao(const RegioesMapa *regioes, int i, int j)
+{
+    int local;
+    const SlotRegiao *slot = SlotResidente(regioes, i, j, &local);
+    return !slot || ((slot->colisao[local >> 3] >> (local & 7)) & 1u);
+}
@@ -0,0 +1,249 @@
+#include "replay.h"
+#include <string.h>
+
+#define TAMANHO_CABECALHO_REPLAY 36
+#define TAMANHO_CABECALHO_REPLAY_V1 24
+#define OFFSET_QUANTIDADE_PASSOS 20
+
+enum {
+    PASSO_CLIQUE_ESQ     = 1 << 0,
+    PASSO_CLIQUE_DIR     = 1 << 1,
+    PASSO_PAUSAR         = 1 << 2,
+    PASSO_DIREITA        = 1 << 3,
+    PASSO_ESQUERDA       = 1 << 4,
+    PASSO_CIMA           = 1 << 5,
+    PASSO_BAIXO          = 1 << 6,
+    PASSO_MOUSE_REPETIDO = 1 << 7
+};
+
+static const char MAGICO_REPLAY[4] = { 'M', 'T', 'A', 'R' };
+
+static void EscreverU16(unsigned char *p, uint16_t v)
+{
+    p[0] = (unsigned char)(v & 0xFF);
+    p[1] = (unsigned char)(v >> 8);
+}
+
+static void EscreverU32(unsigned char *p, uint32_t v)
+{
+    for (int i = 0; i < 4; ++i) p[i] = (unsigned char)(v >> (8 * i));
+}
+
+static void EscreverU64(unsigned char *p, uint64_t v)
+{
+    for (int i = 0; i < 8; ++i) p[i] = (unsigned char)(v >> (8 * i));
+}
+
+static uint16_t LerU16(const unsigned char *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t LerU32(const unsigned char *p)
+{
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= (uint32_t)p[i] << (8 * i);
+    return v;
+}
+
+static uint64_t LerU64(const unsigned char *p)
+{
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+static uint32_t BitsFloat(float f)
+{
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+static float FloatDeBits(uint32_t bits)
+{
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+bool Replay_IniciarGravacao(Replay *r, const char *caminho, const CabecalhoReplay *cabecalho)
+{
+    if (!r || !caminho || !cabecalho) return false;
+    memset(r, 0, sizeof(*r));
+
+    r->arquivo = fopen(caminho, "wb");
+    if (!r->arquivo) {
+        printf("Erro: nao foi possivel criar o replay %s\n", caminho);
+        return false;
+    }
+    r->gravando = true;
+    r->cabecalho = *cabecalho;
+    r->cabecalho.quantidadePassos = 0;
+
+    unsigned char buffer[TAMANHO_CABECALHO_REPLAY];
+    memcpy(buffer, MAGICO_REPLAY, 4);
+    EscreverU16(buffer + 4, REPLAY_VERSAO);
+    EscreverU16(buffer + 6, cabecalho->taxaTicks);
+    EscreverU64(buffer + 8, cabecalho->semente);
+    memcpy(buffer + 16, cabecalho->equipamentos, CAT_TOTAL);
+    EscreverU32(buffer + OFFSET_QUANTIDADE_PASSOS, 0);
+    EscreverU32(buffer + 24, cabecalho->linhasMapa);
+    EscreverU32(buffer + 28, cabecalho->colunasMapa);
+    EscreverU16(buffer + 32, cabecalho->limiteMonstros);
+    EscreverU16(buffer + 34, 0);
+    if (fwrite(buffer, 1, sizeof(buffer), r->arquivo) != sizeof(buffer)) {
+        printf("Erro: falha ao escrever o cabecalho do replay\n");
+        fclose(r->arquivo);
+        r->arquivo = NULL;
+        return false;
+    }
+    return true;
+}
+
+bool Replay_GravarPasso(Replay *r, const EntradaJogo *entrada)
+{
+    if (!r || !r->arquivo || !r->gravando || !entrada) return false;
+
+    unsigned char buffer[9];
+    unsigned char flags = 0;
+    if (entrada->cliqueEsq) flags |= PASSO_CLIQUE_ESQ;
+    if (entrada->cliqueDir) flags |= PASSO_CLIQUE_DIR;
+    if (entrada->pausar) flags |= PASSO_PAUSAR;
+    if (entrada->direcaoMovimento.x > 0.0f) flags |= PASSO_DIREITA;
+    if (entrada->direcaoMovimento.x < 0.0f) flags |= PASSO_ESQUERDA;
+    if (entrada->direcaoMovimento.y < 0.0f) flags |= PASSO_CIMA;
+    if (entrada->direcaoMovimento.y > 0.0f) flags |= PASSO_BAIXO;
+
+    size_t tamanho = 1;
+    bool mouseRepetido = r->cabecalho.quantidadePassos > 0 &&
+                         BitsFloat(entrada->mouseNoMundo.x) == BitsFloat(r->ultimoMouse.x) &&
+                         BitsFloat(entrada->mouseNoMundo.y) == BitsFloat(r->ultimoMouse.y);
+    if (mouseRepetido) {
+        flags |= PASSO_MOUSE_REPETIDO;
+    } else {
+        EscreverU32(buffer + 1, BitsFloat(entrada->mouseNoMundo.x));
+        EscreverU32(buffer + 5, BitsFloat(entrada->mouseNoMundo.y));
+        tamanho = 9;
+        r->ultimoMouse = entrada->mouseNoMundo;
+    }
+    buffer[0] = flags;
+
+    if (fwrite(buffer, 1, tamanho, r->arquivo) != tamanho) return false;
+    r->cabecalho.quantidadePassos++;
+    return true;
+}
+
+bool Replay_AbrirReproducao(Replay *r, const char *caminho)
+{
+    if (!r || !caminho) return false;
+    memset(r, 0, sizeof(*r));
+
+    r->arquivo = fopen(caminho, "rb");
+    if (!r->arquivo) {
+        printf("Erro: nao foi possivel abrir o replay %s\n", caminho);
+        return false;
+    }
+
+    unsigned char buffer[TAMANHO_CABECALHO_REPLAY];
+    if (fread(buffer, 1, TAMANHO_CABECALHO_REPLAY_V1, r->arquivo) != TAMANHO_CABECALHO_REPLAY_V1 ||
+        memcmp(buffer, MAGICO_REPLAY, 4) != 0) {
+        printf("Erro: %s nao e um replay valido\n", caminho);
+        Replay_Fechar(r);
+        return false;
+    }
+    uint16_t versao = LerU16(buffer + 4);
+    if (versao != 1 && versao != REPLAY_VERSAO) {
+        printf("Erro: versao de replay %u nao suportada\n", (unsigned)versao);
+        Replay_Fechar(r);
+        return false;
+    }
+    if (versao >= 2) {
+        size_t resto = TAMANHO_CABECALHO_REPLAY - TAMANHO_CABECALHO_REPLAY_V1;
+        if (fread(buffer + TAMANHO_CABECALHO_REPLAY_V1, 1, resto, r->arquivo) != resto) {
+            printf("Erro: %s nao e um replay valido\n", caminho);
+            Replay_Fechar(r);
+            return false;
+        }
+        r->cabecalho.linhasMapa = LerU32(buffer + 24);
+        r->cabecalho.colunasMapa = LerU32(buffer + 28);
+        r->cabecalho.limiteMonstros = LerU16(buffer + 32);
+    }
+    r->cabecalho.taxaTicks = LerU16(buffer + 6);
+    r->cabecalho.semente = LerU64(buffer + 8);
+    memcpy(r->cabecalho.equipamentos, buffer + 16, CAT_TOTAL);
+    r->cabecalho.quantidadePassos = LerU32(buffer + OFFSET_QUANTIDADE_PASSOS);
+    if (r->cabecalho.taxaTicks == 0) {
+        printf("Erro: replay sem taxa de ticks\n");
+        Replay_Fechar(r);
+        return false;
+    }
+    return true;
+}
+
+bool Replay_ConfereArena(const Replay *r, int linhasMapa, int colunasMapa, int limiteMonstros)
+{
+    if (!r) return false;
+    const CabecalhoReplay *c = &r->cabecalho;
+    if (c->linhasMapa == 0 && c->colunasMapa == 0) {
+        printf("Aviso: replay antigo sem o mapa gravado; confira se e o mesmo da gravacao\n");
+    } else if (c->linhasMapa != (uint32_t)linhasMapa || c->colunasMapa != (uint32_t)colunasMapa) {
+        printf("Erro: replay gravado num mapa de %lux%lu tiles, mas o aberto tem %dx%d\n",
+               (unsigned long)c->linhasMapa, (unsigned long)c->colunasMapa, linhasMapa, colunasMapa);
+        return false;
+    }
+    // Antes da versão 2 o limite era sempre o padrão
+    int limiteGravado = c->limiteMonstros ? c->limiteMonstros : LIMITE_MONSTROS_PADRAO;
+    if (limiteGravado != limiteMonstros) {
+        printf("Erro: replay gravado com --monstros %d, mas a partida usa %d\n", limiteGravado, limiteMonstros);
+        return false;
+    }
+    return true;
+}
+
+bool Replay_LerPasso(Replay *r, EntradaJogo *entrada)
+{
+    if (!r || !r->arquivo || r->gravando || !entrada) return false;
+    if (r->cabecalho.quantidadePassos > 0 && r->passosProcessados >= r->cabecalho.quantidadePassos) {
+        return false;
+    }
+
+    int flags = fgetc(r->arquivo);
+    if (flags == EOF) return false;
+    if (!(flags & PASSO_MOUSE_REPETIDO)) {
+        unsigned char buffer[8];
+        if (fread(buffer, 1, sizeof(buffer), r->arquivo) != sizeof(buffer)) return false;
+        r->ultimoMouse.x = FloatDeBits(LerU32(buffer));
+        r->ultimoMouse.y = FloatDeBits(LerU32(buffer + 4));
+    }
+
+    entrada->cliqueEsq = (flags & PASSO_CLIQUE_ESQ) != 0;
+    entrada->cliqueDir = (flags & PASSO_CLIQUE_DIR) != 0;
+    entrada->pausar = (flags & PASSO_PAUSAR) != 0;
+    entrada->direcaoMovimento.x = ((flags & PASSO_DIREITA) ? 1.0f : 0.0f) - ((flags & PASSO_ESQUERDA) ? 1.0f : 0.0f);
+    entrada->direcaoMovimento.y = ((flags & PASSO_BAIXO) ? 1.0f : 0.0f) - ((flags & PASSO_CIMA) ? 1.0f : 0.0f);
+    entrada->mouseNoMundo = r->ultimoMouse;
+    r->passosProcessados++;
+    return true;
+}
+
+void Replay_Fechar(Replay *r)
+{
+    if (!r || !r->arquivo) return;
+    if (r->gravando) {
+        unsigned char buffer[4];
+        EscreverU32(buffer, r->cabecalho.quantidadePassos);
+        if (fseek(r->arquivo, OFFSET_QUANTIDADE_PASSOS, SEEK_SET) != 0 ||
+            fwrite(buffer, 1, sizeof(buffer), r->arquivo) != sizeof(buffer)) {
+            printf("Aviso: nao foi possivel finalizar o replay\n");
+        }
+    }
+    fclose(r->arquivo);
+    r->arquivo = NULL;
+    r->gravando = false;
+}
+
+bool Replay_Aberto(const Replay *r)
+{
+    return r && r->arquivo != NULL;
+}
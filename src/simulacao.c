@@ -0,0 +1,410 @@
+#include "simulacao.h"
+#include "jogo.h"
+#include "jogador.h"
+#include "mapa.h"
+#include "equipamentos.h"
+#include "texturas.h"
+#include "replay.h"
+#include "perfil.h"
+#include "alocacoes.h"
+#include "tarefas.h"
+#include "rascunho.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Sem texturas não há de onde ler o tamanho do tile: usa o dos assets
+#define TAMANHO_TILE_HEADLESS 64
+#define PASSO_SIMULACAO (1.0f / TAXA_TICKS_PADRAO)
+#define DISTANCIA_FUGA_ROTEIRO 220.0f
+#define ALCANCE_SECUNDARIA_ROTEIRO 260.0f
+
+typedef struct {
+    int partidas;
+    float duracaoMaxima;
+    uint64_t semente;
+    const char *caminhoGravacao;      // grava a primeira partida do lote
+    const char *caminhoReproducao;    // reproduz um replay em vez de usar o roteiro
+    const char *caminhoTrace;         // eventos do profiler (exige PERFIL=1)
+    const char *caminhoMapa;          // arena lida de arquivo por regiões
+    int threads;                      // 0 = um por núcleo; 1 = tudo na thread principal
+    int limiteMonstros;               // 0 = LIMITE_MONSTROS_PADRAO
+} ConfigSimulacao;
+
+typedef struct {
+    size_t indices[CAT_TOTAL];
+    ArmaPrincipal *armaPrincipal;
+    const ArmaSecundaria *armaSecundaria;
+    const Armadura *armadura;
+    const Capacete *capacete;
+} EquipamentoPartida;
+
+typedef struct {
+    float tempoSobrevivido;
+    int pontuacao;
+    int picoMonstros;
+    long passos;
+    bool morreu;
+} ResultadoPartida;
+
+static void LerArgumentos(ConfigSimulacao *config, int argc, char **argv)
+{
+    config->partidas = 100;
+    config->duracaoMaxima = 300.0f;
+    config->semente = 1;
+    config->caminhoGravacao = NULL;
+    config->caminhoReproducao = NULL;
+    config->caminhoTrace = NULL;
+    config->caminhoMapa = NULL;
+    config->threads = 0;
+    config->limiteMonstros = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const char *valor = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(arg, "--headless") == 0) {
+            continue;
+        } else if (strcmp(arg, "--partidas") == 0 && valor) {
+            config->partidas = atoi(valor);
+            ++i;
+        } else if (strcmp(arg, "--duracao") == 0 && valor) {
+            config->duracaoMaxima = (float)atof(valor);
+            ++i;
+        } else if (strcmp(arg, "--semente") == 0 && valor) {
+            config->semente = (uint64_t)strtoull(valor, NULL, 10);
+            ++i;
+        } else if (strcmp(arg, "--gravar") == 0 && valor) {
+            config->caminhoGravacao = valor;
+            ++i;
+        } else if (strcmp(arg, "--reproduzir") == 0 && valor) {
+            config->caminhoReproducao = valor;
+            ++i;
+        } else if (strcmp(arg, "--trace") == 0 && valor) {
+            config->caminhoTrace = valor;
+            ++i;
+        } else if (strcmp(arg, "--mapa") == 0 && valor) {
+            config->caminhoMapa = valor;
+            ++i;
+        } else if (strcmp(arg, "--threads") == 0 && valor) {
+            config->threads = atoi(valor);
+            ++i;
+        } else if (strcmp(arg, "--monstros") == 0 && valor) {
+            config->limiteMonstros = atoi(valor);
+            ++i;
+        } else {
+            printf("Aviso: argumento ignorado: %s\n", arg);
+        }
+    }
+    if (config->partidas < 1) config->partidas = 1;
+    if (config->duracaoMaxima <= 0.0f) config->duracaoMaxima = 300.0f;
+}
+
+// Reduz a direção ao que um teclado produziria (-1, 0 ou 1 por eixo), para que
+// a partida possa ser gravada em replay sem perder precisão
+static float EixoTecla(float valor)
+{
+    if (valor > 0.3f) return 1.0f;
+    if (valor < -0.3f) return -1.0f;
+    return 0.0f;
+}
+
+// Roteiro de entrada: foge do monstro mais próximo, volta ao centro quando se
+// afasta demais, mira no mais próximo e aciona as duas armas sempre que pode.
+static EntradaJogo GerarEntradaRoteiro(const EstadoJogo *estado, const Jogador *jogador, Vector2 centroMapa)
+{
+    EntradaJogo entrada = {0};
+    const ConjuntoMonstros *monstros = &estado->monstros;
+
+    int maisProximo = -1;
+    float menorDist2 = 0.0f;
+    for (int i = 0; i < monstros->quantidade; ++i) {
+        float dx = monstros->posX[i] - jogador->posicao.x;
+        float dy = monstros->posY[i] - jogador->posicao.y;
+        float dist2 = dx * dx + dy * dy;
+        if (maisProximo < 0 || dist2 < menorDist2) {
+            maisProximo = i;
+            menorDist2 = dist2;
+        }
+    }
+
+    Vector2 direcao = { centroMapa.x - jogador->posicao.x, centroMapa.y - jogador->posicao.y };
+    float distCentro = sqrtf(direcao.x * direcao.x + direcao.y * direcao.y);
+    if (distCentro > 6.0f * TAMANHO_TILE_HEADLESS) {
+        direcao.x /= distCentro;
+        direcao.y /= distCentro;
+    } else {
+        direcao = (Vector2){0.0f, 0.0f};
+    }
+
+    entrada.mouseNoMundo = (Vector2){ jogador->posicao.x + 1.0f, jogador->posicao.y };
+    if (maisProximo >= 0) {
+        Vector2 alvo = { monstros->posX[maisProximo], monstros->posY[maisProximo] };
+        float dist = sqrtf(menorDist2);
+        if (dist > 0.01f && dist < DISTANCIA_FUGA_ROTEIRO) {
+            direcao.x += (jogador->posicao.x - alvo.x) / dist * 2.0f;
+            direcao.y += (jogador->posicao.y - alvo.y) / dist * 2.0f;
+        }
+        entrada.mouseNoMundo = alvo;
+        entrada.cliqueEsq = true;
+        entrada.cliqueDir = dist < ALCANCE_SECUNDARIA_ROTEIRO;
+    }
+    entrada.direcaoMovimento = (Vector2){ EixoTecla(direcao.x), EixoTecla(direcao.y) };
+    return entrada;
+}
+
+static size_t IndiceEquipamento(CategoriaEquipamento cat, size_t *combinacao)
+{
+    size_t quantidade = Equipamento_QuantidadePorCategoria(cat);
+    if (quantidade == 0) return 0;
+    size_t indice = *combinacao % quantidade;
+    *combinacao /= quantidade;
+    return indice;
+}
+
+static EquipamentoPartida SelecionarEquipamento(const size_t indices[CAT_TOTAL])
+{
+    EquipamentoPartida equip;
+    memset(&equip, 0, sizeof(equip));
+    for (int cat = 0; cat < CAT_TOTAL; ++cat) {
+        size_t quantidade = Equipamento_QuantidadePorCategoria((CategoriaEquipamento)cat);
+        equip.indices[cat] = (indices[cat] < quantidade) ? indices[cat] : 0;
+    }
+    if (gQuantidadeArmasPrincipais > 0) equip.armaPrincipal = &gArmasPrincipais[equip.indices[CAT_ARMA_PRINCIPAL]];
+    if (gQuantidadeArmasSecundarias > 0) equip.armaSecundaria = &gArmasSecundarias[equip.indices[CAT_ARMA_SECUNDARIA]];
+    if (gQuantidadeArmaduras > 0) equip.armadura = &gArmaduras[equip.indices[CAT_ARMADURA]];
+    if (gQuantidadeCapacetes > 0) equip.capacete = &gCapacetes[equip.indices[CAT_CAPACETE]];
+    return equip;
+}
+
+static void PrepararPartida(EstadoJogo *estado, Jogador *jogador, Mapa *mapa, Camera2D *camera,
+                            const EquipamentoPartida *equip, float vidaBaseJogador, uint64_t semente)
+{
+    if (equip->armaPrincipal) equip->armaPrincipal->tempoRecargaRestante = 0.0f;
+    estado->regeneracaoAtual = AtualizarVidaJogadorComEquipamentos(jogador, equip->armadura, equip->capacete,
+                                                                   vidaBaseJogador, equip->armaPrincipal);
+    jogador->vida = jogador->vidaMaxima;
+
+    const int tile = TAMANHO_TILE_HEADLESS;
+    Vector2 centroMapa = { mapa->colunas * tile / 2.0f, mapa->linhas * tile / 2.0f };
+    *camera = (Camera2D){ .zoom = 1.0f };
+    JogoReiniciar(estado, jogador, camera, centroMapa, semente);
+    AtualizarRegioesMapa(mapa, jogador->posicao);
+    AtualizarTileAtualJogador(jogador, mapa);
+}
+
+static void ExecutarPasso(EstadoJogo *estado, Jogador *jogador, Mapa *mapa, Camera2D *camera,
+                          const EquipamentoPartida *equip, float dt, const EntradaJogo *entrada,
+                          ResultadoPartida *resultado)
+{
+    const int tile = TAMANHO_TILE_HEADLESS;
+    PERFIL_INICIO(PERFIL_SIMULACAO);
+    // Cada passo faz as vezes de um quadro do jogo
+    Rascunho_NovoQuadro();
+    ALOCACOES_INICIO("JogoAtualizar", estado->tempoTotalJogo);
+    JogoAtualizar(estado, jogador, camera, mapa, mapa->linhas, mapa->colunas, tile, tile,
+                  dt, entrada,
+                  equip->armadura, equip->capacete, equip->armaPrincipal, equip->armaSecundaria);
+    ALOCACOES_FIM();
+    PERFIL_FIM(PERFIL_SIMULACAO);
+    resultado->passos++;
+    if (estado->monstros.quantidade > resultado->picoMonstros) {
+        resultado->picoMonstros = estado->monstros.quantidade;
+    }
+}
+
+static void ImprimirResultado(int partida, uint64_t semente, const EquipamentoPartida *equip,
+                              ResultadoPartida *resultado, const EstadoJogo *estado)
+{
+    resultado->tempoSobrevivido = estado->tempoTotalJogo;
+    resultado->pontuacao = estado->pontuacaoTotal;
+    resultado->morreu = estado->jogadorMorto;
+
+    printf("%d,%llu,%s,%s,%s,%s,%.2f,%d,%d,%d\n",
+           partida,
+           (unsigned long long)semente,
+           Equipamento_NomeCategoria(CAT_ARMA_PRINCIPAL, equip->indices[CAT_ARMA_PRINCIPAL]),
+           Equipamento_NomeCategoria(CAT_ARMA_SECUNDARIA, equip->indices[CAT_ARMA_SECUNDARIA]),
+           Equipamento_NomeCategoria(CAT_ARMADURA, equip->indices[CAT_ARMADURA]),
+           Equipamento_NomeCategoria(CAT_CAPACETE, equip->indices[CAT_CAPACETE]),
+           resultado->tempoSobrevivido,
+           resultado->pontuacao,
+           resultado->picoMonstros,
+           resultado->morreu ? 1 : 0);
+}
+
+static ResultadoPartida ExecutarPartida(int partida, const ConfigSimulacao *config,
+                                        EstadoJogo *estado, Jogador *jogador, Mapa *mapa,
+                                        float vidaBaseJogador, Replay *gravacao)
+{
+    ResultadoPartida resultado = {0};
+    uint64_t semente = config->semente + (uint64_t)partida;
+
+    // Percorre todas as combinações de equipamento ao longo das partidas
+    size_t combinacao = (size_t)partida;
+    size_t indices[CAT_TOTAL];
+    for (int cat = 0; cat < CAT_TOTAL; ++cat) {
+        indices[cat] = IndiceEquipamento((CategoriaEquipamento)cat, &combinacao);
+    }
+    EquipamentoPartida equip = SelecionarEquipamento(indices);
+
+    Camera2D camera;
+    PrepararPartida(estado, jogador, mapa, &camera, &equip, vidaBaseJogador, semente);
+    const int tile = TAMANHO_TILE_HEADLESS;
+    Vector2 centroMapa = { mapa->colunas * tile / 2.0f, mapa->linhas * tile / 2.0f };
+
+    if (gravacao) {
+        CabecalhoReplay cabecalho = {
+            .semente = semente,
+            .taxaTicks = TAXA_TICKS_PADRAO,
+            .linhasMapa = (uint32_t)mapa->linhas,
+            .colunasMapa = (uint32_t)mapa->colunas,
+            .limiteMonstros = (uint16_t)estado->limiteMonstros
+        };
+        for (int cat = 0; cat < CAT_TOTAL; ++cat) cabecalho.equipamentos[cat] = (uint8_t)equip.indices[cat];
+        if (!Replay_IniciarGravacao(gravacao, config->caminhoGravacao, &cabecalho)) gravacao = NULL;
+    }
+
+    while (!estado->jogadorMorto && estado->tempoTotalJogo < config->duracaoMaxima) {
+        EntradaJogo entrada = GerarEntradaRoteiro(estado, jogador, centroMapa);
+        if (gravacao) Replay_GravarPasso(gravacao, &entrada);
+        ExecutarPasso(estado, jogador, mapa, &camera, &equip, PASSO_SIMULACAO, &entrada, &resultado);
+    }
+    if (gravacao) Replay_Fechar(gravacao);
+
+    ImprimirResultado(partida, semente, &equip, &resultado, estado);
+    return resultado;
+}
+
+static ResultadoPartida ExecutarReplay(Replay *replay, EstadoJogo *estado, Jogador *jogador,
+                                       Mapa *mapa, float vidaBaseJogador)
+{
+    ResultadoPartida resultado = {0};
+    const CabecalhoReplay *cabecalho = &replay->cabecalho;
+    size_t indices[CAT_TOTAL];
+    for (int cat = 0; cat < CAT_TOTAL; ++cat) indices[cat] = cabecalho->equipamentos[cat];
+    EquipamentoPartida equip = SelecionarEquipamento(indices);
+
+    Camera2D camera;
+    PrepararPartida(estado, jogador, mapa, &camera, &equip, vidaBaseJogador, cabecalho->semente);
+
+    const float dt = 1.0f / (float)cabecalho->taxaTicks;
+    EntradaJogo entrada;
+    memset(&entrada, 0, sizeof(entrada));
+    while (Replay_LerPasso(replay, &entrada)) {
+        ExecutarPasso(estado, jogador, mapa, &camera, &equip, dt, &entrada, &resultado);
+    }
+
+    ImprimirResultado(0, cabecalho->semente, &equip, &resultado, estado);
+    return resultado;
+}
+
+int SimulacaoExecutar(int argc, char **argv)
+{
+    ConfigSimulacao config;
+    LerArgumentos(&config, argc, argv);
+#ifdef MTA_PERFIL
+    if (config.caminhoTrace) Perfil_IniciarTrace(config.caminhoTrace);
+#else
+    if (config.caminhoTrace) printf("Aviso: --trace exige compilar com PERFIL=1\n");
+#endif
+
+    Tarefas_Inicializar(config.threads);
+    if (!Rascunho_Inicializar(RASCUNHO_CAPACIDADE_PADRAO)) {
+        Tarefas_Finalizar();
+        return 1;
+    }
+    Texturas_DefinirSemGPU(true);
+    Texturas_Inicializar();
+    CarregarTexturasMonstros();
+
+    const int tile = TAMANHO_TILE_HEADLESS;
+    Mapa *mapa = config.caminhoMapa ? AbrirMapaArquivo(config.caminhoMapa, tile, tile)
+                                    : criar_mapa(MAPA_LINHAS, MAPA_COLUNAS, tile, tile);
+    if (!mapa) {
+        printf("Erro: Nao foi possivel criar o mapa\n");
+        Texturas_Finalizar();
+        Tarefas_Finalizar();
+        Rascunho_Finalizar();
+        return 1;
+    }
+
+    // Mesmos atributos base de IniciarJogadorPadrao (app.c)
+    Jogador jogador;
+    memset(&jogador, 0, sizeof(jogador));
+    if (!IniciarJogador(&jogador, (Vector2){0.0f, 0.0f}, 400.0f, 10.0f, 100.0f,
+                        "assets/personagem/personagemParado.png",
+                        "assets/personagem/personagemAndando1.png",
+                        "assets/personagem/personagemAndando2.png")) {
+        printf("Erro: Nao foi possivel iniciar o jogador\n");
+        destruir_mapa(mapa);
+        Texturas_Finalizar();
+        Tarefas_Finalizar();
+        Rascunho_Finalizar();
+        return 1;
+    }
+    float vidaBaseJogador = jogador.vidaMaxima;
+
+    EstadoJogo estado;
+    JogoInicializar(&estado, jogador.regeneracaoBase, config.limiteMonstros);
+
+    Replay replay;
+    memset(&replay, 0, sizeof(replay));
+    if (config.caminhoReproducao) {
+        if (!Replay_AbrirReproducao(&replay, config.caminhoReproducao) ||
+            !Replay_ConfereArena(&replay, mapa->linhas, mapa->colunas, estado.limiteMonstros)) {
+            Replay_Fechar(&replay);
+            JogoLiberarRecursos(&estado);
+            DescarregarJogador(&jogador);
+            destruir_mapa(mapa);
+            DescarregarTexturasMonstros();
+            Texturas_Finalizar();
+            Tarefas_Finalizar();
+            Rascunho_Finalizar();
+            return 1;
+        }
+        config.partidas = 1;
+    }
+
+    printf("partida,semente,arma_principal,arma_secundaria,armadura,capacete,tempo_s,pontos,pico_monstros,morreu\n");
+    long passosTotais = 0;
+    clock_t inicio = clock();
+    if (config.caminhoReproducao) {
+        passosTotais = ExecutarReplay(&replay, &estado, &jogador, mapa, vidaBaseJogador).passos;
+        Replay_Fechar(&replay);
+    } else {
+        for (int p = 0; p < config.partidas; ++p) {
+            Replay *gravacao = (p == 0 && config.caminhoGravacao) ? &replay : NULL;
+            ResultadoPartida resultado = ExecutarPartida(p, &config, &estado, &jogador, mapa,
+                                                         vidaBaseJogador, gravacao);
+            passosTotais += resultado.passos;
+            PERFIL_DESCARREGAR_TRACE();
+        }
+    }
+    double segundos = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    if (segundos <= 0.0) segundos = 1e-6;
+
+    fprintf(stderr, "%d partidas, %ld passos em %.2f s (%.0f partidas/min, %.0f passos/s)\n",
+            config.partidas, passosTotais, segundos,
+            config.partidas * 60.0 / segundos, passosTotais / segundos);
+    const Arena *arena = &estado.memoriaPartida;
+    if (arena->base) {
+        fprintf(stderr, "arena da partida: %.1f de %.1f KiB, %d reservas por partida, %d falhas\n",
+                arena->pico / 1024.0, arena->capacidade / 1024.0, arena->reservas, arena->falhas);
+    }
+    const Arena *rascunho = Rascunho_Estatisticas();
+    fprintf(stderr, "rascunho por quadro: pico de %.1f de %.1f KiB, %d falhas\n",
+            rascunho->pico / 1024.0, rascunho->capacidade / 1024.0, rascunho->falhas);
+
+    JogoLiberarRecursos(&estado);
+    DescarregarJogador(&jogador);
+    destruir_mapa(mapa);
+    DescarregarTexturasMonstros();
+    Texturas_Finalizar();
+    Tarefas_Finalizar();
+    Rascunho_Finalizar();
+    PERFIL_FINALIZAR_TRACE();
+    ALOCACOES_RELATORIO();
+    return 0;
+}
@@ -0,0 +1,241 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "tarefas.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+// Faixa de lotes ainda não iniciados de uma thread: a dona consome pelo
+// começo, quem rouba leva a metade final
+typedef struct {
+    pthread_mutex_t trava;
+    int proximo;
+    int fim;
+} FaixaLotes;
+
+typedef struct {
+    bool iniciado;
+    int threads;                    // inclui a principal (índice 0)
+    pthread_t auxiliares[TAREFAS_MAX_THREADS];
+    FaixaLotes faixas[TAREFAS_MAX_THREADS];
+
+    pthread_mutex_t trava;
+    pthread_cond_t temTrabalho;
+    unsigned int geracao;           // muda a cada ParaleloPara; protegida por `trava`
+    bool encerrar;
+    int ativos;                     // auxiliares dentro de ExecutarLotes (atômico; só sobe com `trava`)
+
+    // Laço atual: escrito pela principal antes de distribuir as faixas e só
+    // lido por quem já pegou um lote dele
+    FuncaoTarefa funcao;
+    void *contexto;
+    int total;
+    int tamanhoLote;
+    int pendentes;                  // lotes não concluídos (atômico)
+} SistemaTarefas;
+
+static SistemaTarefas gTarefas = {0};
+
+static int ContarNucleos(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    return nucleos > 0 ? (int)nucleos : 1;
+#else
+    return 1;
+#endif
+}
+
+static bool PegarLote(FaixaLotes *faixa, int *lote)
+{
+    bool pegou = false;
+    pthread_mutex_lock(&faixa->trava);
+    if (faixa->proximo < faixa->fim) {
+        *lote = faixa->proximo++;
+        pegou = true;
+    }
+    pthread_mutex_unlock(&faixa->trava);
+    return pegou;
+}
+
+// Move para a faixa de `ladrao` a metade final da primeira faixa alheia com
+// trabalho. Só a dona aumenta a própria faixa, então se ela está vazia aqui
+// continua vazia até a cópia abaixo; com trabalho nela, nada é sobrescrito.
+static bool RoubarLotes(int ladrao)
+{
+    FaixaLotes *propria = &gTarefas.faixas[ladrao];
+    pthread_mutex_lock(&propria->trava);
+    bool temTrabalho = propria->proximo < propria->fim;
+    pthread_mutex_unlock(&propria->trava);
+    if (temTrabalho) return true;
+
+    for (int k = 1; k < gTarefas.threads; ++k) {
+        FaixaLotes *vitima = &gTarefas.faixas[(ladrao + k) % gTarefas.threads];
+        int inicio = 0, fim = 0;
+        pthread_mutex_lock(&vitima->trava);
+        int restante = vitima->fim - vitima->proximo;
+        if (restante > 0) {
+            fim = vitima->fim;
+            inicio = fim - (restante + 1) / 2;
+            vitima->fim = inicio;
+        }
+        pthread_mutex_unlock(&vitima->trava);
+        if (inicio == fim) continue;
+
+        pthread_mutex_lock(&propria->trava);
+        propria->proximo = inicio;
+        propria->fim = fim;
+        pthread_mutex_unlock(&propria->trava);
+        return true;
+    }
+    return false;
+}
+
+// Executa lotes do laço atual até não sobrar nenhum a pegar
+static void ExecutarLotes(int indice)
+{
+    FaixaLotes *propria = &gTarefas.faixas[indice];
+    for (;;) {
+        int lote;
+        if (!PegarLote(propria, &lote)) {
+            if (!RoubarLotes(indice)) return;
+            continue;
+        }
+        int inicio = lote * gTarefas.tamanhoLote;
+        int fim = inicio + gTarefas.tamanhoLote;
+        if (fim > gTarefas.total) fim = gTarefas.total;
+        gTarefas.funcao(gTarefas.contexto, inicio, fim);
+        __atomic_sub_fetch(&gTarefas.pendentes, 1, __ATOMIC_ACQ_REL);
+    }
+}
+
+static void *ExecutarAuxiliar(void *arg)
+{
+    int indice = (int)(intptr_t)arg;
+    unsigned int geracaoVista = 0;
+    for (;;) {
+        pthread_mutex_lock(&gTarefas.trava);
+        while (!gTarefas.encerrar && gTarefas.geracao == geracaoVista) {
+            pthread_cond_wait(&gTarefas.temTrabalho, &gTarefas.trava);
+        }
+        bool encerrar = gTarefas.encerrar;
+        geracaoVista = gTarefas.geracao;
+        if (!encerrar) __atomic_add_fetch(&gTarefas.ativos, 1, __ATOMIC_ACQ_REL);
+        pthread_mutex_unlock(&gTarefas.trava);
+        if (encerrar) break;
+        ExecutarLotes(indice);
+        __atomic_sub_fetch(&gTarefas.ativos, 1, __ATOMIC_ACQ_REL);
+    }
+    return NULL;
+}
+
+bool Tarefas_Inicializar(int threads)
+{
+    if (gTarefas.iniciado) return true;
+    if (threads <= 0) threads = ContarNucleos();
+    if (threads > TAREFAS_MAX_THREADS) threads = TAREFAS_MAX_THREADS;
+    if (threads < 1) threads = 1;
+
+    pthread_mutex_init(&gTarefas.trava, NULL);
+    pthread_cond_init(&gTarefas.temTrabalho, NULL);
+    for (int i = 0; i < TAREFAS_MAX_THREADS; ++i) {
+        pthread_mutex_init(&gTarefas.faixas[i].trava, NULL);
+        gTarefas.faixas[i].proximo = 0;
+        gTarefas.faixas[i].fim = 0;
+    }
+    gTarefas.geracao = 0;
+    gTarefas.encerrar = false;
+    gTarefas.ativos = 0;
+    gTarefas.threads = 1;
+    gTarefas.iniciado = true;
+
+    for (int i = 1; i < threads; ++i) {
+        if (pthread_create(&gTarefas.auxiliares[i], NULL, ExecutarAuxiliar, (void *)(intptr_t)i) != 0) {
+            printf("Aviso: sistema de tarefas com %d de %d threads\n", i, threads);
+            break;
+        }
+        gTarefas.threads = i + 1;
+    }
+    return true;
+}
+
+void Tarefas_Finalizar(void)
+{
+    if (!gTarefas.iniciado) return;
+    pthread_mutex_lock(&gTarefas.trava);
+    gTarefas.encerrar = true;
+    pthread_cond_broadcast(&gTarefas.temTrabalho);
+    pthread_mutex_unlock(&gTarefas.trava);
+    for (int i = 1; i < gTarefas.threads; ++i) {
+        pthread_join(gTarefas.auxiliares[i], NULL);
+    }
+    for (int i = 0; i < TAREFAS_MAX_THREADS; ++i) {
+        pthread_mutex_destroy(&gTarefas.faixas[i].trava);
+    }
+    pthread_cond_destroy(&gTarefas.temTrabalho);
+    pthread_mutex_destroy(&gTarefas.trava);
+    gTarefas.iniciado = false;
+    gTarefas.threads = 0;
+}
+
+int Tarefas_Threads(void)
+{
+    return gTarefas.iniciado ? gTarefas.threads : 1;
+}
+
+void Tarefas_ParaleloPara(int total, int tamanhoLote, FuncaoTarefa funcao, void *contexto)
+{
+    if (total <= 0 || !funcao) return;
+    if (tamanhoLote < 1) tamanhoLote = 1;
+    int lotes = (total + tamanhoLote - 1) / tamanhoLote;
+    if (!gTarefas.iniciado || gTarefas.threads < 2 || lotes < 2) {
+        funcao(contexto, 0, total);
+        return;
+    }
+
+    // Um auxiliar do laço anterior pode ainda estar saindo de ExecutarLotes
+    // (ou roubando) depois do último lote; com `trava` nenhum outro entra, e
+    // as faixas só mudam quando todos estiverem parados
+    pthread_mutex_lock(&gTarefas.trava);
+    while (__atomic_load_n(&gTarefas.ativos, __ATOMIC_ACQUIRE) > 0) {
+        sched_yield();
+    }
+
+    gTarefas.funcao = funcao;
+    gTarefas.contexto = contexto;
+    gTarefas.total = total;
+    gTarefas.tamanhoLote = tamanhoLote;
+    __atomic_store_n(&gTarefas.pendentes, lotes, __ATOMIC_RELAXED);
+
+    // Faixas contíguas: cada thread começa numa parte diferente dos dados
+    for (int t = 0; t < gTarefas.threads; ++t) {
+        FaixaLotes *faixa = &gTarefas.faixas[t];
+        pthread_mutex_lock(&faixa->trava);
+        faixa->proximo = (int)((long)lotes * t / gTarefas.threads);
+        faixa->fim = (int)((long)lotes * (t + 1) / gTarefas.threads);
+        pthread_mutex_unlock(&faixa->trava);
+    }
+
+    gTarefas.geracao++;
+    pthread_cond_broadcast(&gTarefas.temTrabalho);
+    pthread_mutex_unlock(&gTarefas.trava);
+
+    ExecutarLotes(0);
+    // Lotes roubados podem ainda estar rodando em outra thread
+    while (__atomic_load_n(&gTarefas.pendentes, __ATOMIC_ACQUIRE) > 0) {
+        sched_yield();
+    }
+}
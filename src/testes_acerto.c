@@ -0,0 +1,229 @@
+#include "testes_acerto.h"
+#include <float.h>
+#include <math.h>
+#include <stdbool.h>
+
+// Camada fina sobre as intrínsecas: cada kernel é escrito uma vez com V_* e
+// vale para as duas larguras. Só operações IEEE exatas (sem FMA nem
+// recíprocas aproximadas), para o laço escalar do resto dar o mesmo resultado.
+#if !defined(MTA_SEM_SIMD) && defined(__AVX2__)
+#include <immintrin.h>
+#define LARGURA_SIMD 8
+#define IMPLEMENTACAO "AVX2"
+typedef __m256 VetorF;
+#define V_CARREGAR(p)           _mm256_loadu_ps(p)
+#define V_REPETIR(v)            _mm256_set1_ps(v)
+#define V_SOMAR(a, b)           _mm256_add_ps((a), (b))
+#define V_SUBTRAIR(a, b)        _mm256_sub_ps((a), (b))
+#define V_MULTIPLICAR(a, b)     _mm256_mul_ps((a), (b))
+#define V_MINIMO(a, b)          _mm256_min_ps((a), (b))
+#define V_MAXIMO(a, b)          _mm256_max_ps((a), (b))
+#define V_RAIZ(a)               _mm256_sqrt_ps(a)
+#define V_MENOR_IGUAL(a, b)     _mm256_cmp_ps((a), (b), _CMP_LE_OQ)
+#define V_E(a, b)               _mm256_and_ps((a), (b))
+#define V_OU(a, b)              _mm256_or_ps((a), (b))
+#define V_BITS(a)               _mm256_movemask_ps(a)
+#elif !defined(MTA_SEM_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define LARGURA_SIMD 4
+#define IMPLEMENTACAO "SSE2"
+typedef __m128 VetorF;
+#define V_CARREGAR(p)           _mm_loadu_ps(p)
+#define V_REPETIR(v)            _mm_set1_ps(v)
+#define V_SOMAR(a, b)           _mm_add_ps((a), (b))
+#define V_SUBTRAIR(a, b)        _mm_sub_ps((a), (b))
+#define V_MULTIPLICAR(a, b)     _mm_mul_ps((a), (b))
+#define V_MINIMO(a, b)          _mm_min_ps((a), (b))
+#define V_MAXIMO(a, b)          _mm_max_ps((a), (b))
+#define V_RAIZ(a)               _mm_sqrt_ps(a)
+#define V_MENOR_IGUAL(a, b)     _mm_cmple_ps((a), (b))
+#define V_E(a, b)               _mm_and_ps((a), (b))
+#define V_OU(a, b)              _mm_or_ps((a), (b))
+#define V_BITS(a)               _mm_movemask_ps(a)
+#else
+#define IMPLEMENTACAO "escalar"
+#endif
+
+#ifdef LARGURA_SIMD
+static int EscreverMascara(uint8_t *mascara, int bits)
+{
+    int acertos = 0;
+    for (int k = 0; k < LARGURA_SIMD; ++k) {
+        mascara[k] = (uint8_t)((bits >> k) & 1);
+        acertos += mascara[k];
+    }
+    return acertos;
+}
+#endif
+
+ConeAcerto TestesAcerto_PrepararCone(Vector2 origem, Vector2 direcao, float alcance,
+                                     float aberturaGraus, float raioExtra)
+{
+    ConeAcerto cone;
+    float comprimento = sqrtf(direcao.x * direcao.x + direcao.y * direcao.y);
+    if (comprimento <= 0.0001f) {
+        direcao = (Vector2){ 1.0f, 0.0f };
+        comprimento = 1.0f;
+    }
+    if (raioExtra < 0.0f) raioExtra = 0.0f;
+    float meia = aberturaGraus * 0.5f * DEG2RAD;
+    if (meia < 0.0f) meia = 0.0f;
+
+    cone.origemX = origem.x;
+    cone.origemY = origem.y;
+    cone.eixoX = direcao.x / comprimento;
+    cone.eixoY = direcao.y / comprimento;
+    cone.raio = raioExtra;
+    cone.raio2 = raioExtra * raioExtra;
+    cone.limite2 = (alcance + raioExtra) * (alcance + raioExtra);
+    if (meia >= PI) {
+        // Círculo inteiro: só o alcance conta
+        cone.cosMeia = -1.0f;
+        cone.sinMeia = 0.0f;
+        cone.sinMeia2Largo = 0.0f;
+    } else {
+        cone.cosMeia = cosf(meia);
+        cone.sinMeia = sinf(meia);
+        // Acima de 90° a soma meia + asin(r/d) pode passar de 180°, onde o
+        // cosseno volta a crescer: nesses casos r/d >= sen(meia) já é acerto
+        cone.sinMeia2Largo = (meia >= PI * 0.5f) ? cone.sinMeia * cone.sinMeia : FLT_MAX;
+    }
+    return cone;
+}
+
+CapsulaAcerto TestesAcerto_PrepararCapsula(Vector2 inicio, Vector2 fim, float raio)
+{
+    CapsulaAcerto capsula;
+    capsula.inicioX = inicio.x;
+    capsula.inicioY = inicio.y;
+    capsula.segX = fim.x - inicio.x;
+    capsula.segY = fim.y - inicio.y;
+    float comprimento2 = capsula.segX * capsula.segX + capsula.segY * capsula.segY;
+    capsula.inversoComprimento2 = (comprimento2 > 0.0001f) ? 1.0f / comprimento2 : 0.0f;
+    if (raio < 0.0f) raio = 0.0f;
+    capsula.raio2 = raio * raio;
+    return capsula;
+}
+
+int TestesAcerto_Circulo(const float *x, const float *y, int n, Vector2 centro, float raio,
+                         uint8_t *mascara)
+{
+    const float raio2 = raio * raio;
+    int acertos = 0;
+    int i = 0;
+#ifdef LARGURA_SIMD
+    const VetorF cx = V_REPETIR(centro.x), cy = V_REPETIR(centro.y), r2 = V_REPETIR(raio2);
+    for (; i + LARGURA_SIMD <= n; i += LARGURA_SIMD) {
+        VetorF dx = V_SUBTRAIR(V_CARREGAR(x + i), cx);
+        VetorF dy = V_SUBTRAIR(V_CARREGAR(y + i), cy);
+        VetorF d2 = V_SOMAR(V_MULTIPLICAR(dx, dx), V_MULTIPLICAR(dy, dy));
+        acertos += EscreverMascara(mascara + i, V_BITS(V_MENOR_IGUAL(d2, r2)));
+    }
+#endif
+    for (; i < n; ++i) {
+        float dx = x[i] - centro.x;
+        float dy = y[i] - centro.y;
+        mascara[i] = (uint8_t)(dx * dx + dy * dy <= raio2);
+        acertos += mascara[i];
+    }
+    return acertos;
+}
+
+// Dentro do alcance, acerta quando cos(ângulo) >= cos(meia + asin(r/d)), isto é,
+// eixo·delta >= cosMeia * sqrt(d² - r²) - sinMeia * r. Com r >= d o asin
+// satura em 90° e o limiar vira -sinMeia * d, daí o min(r, d).
+int TestesAcerto_Cone(const float *x, const float *y, int n, const ConeAcerto *cone, uint8_t *mascara)
+{
+    int acertos = 0;
+    int i = 0;
+#ifdef LARGURA_SIMD
+    const VetorF ox = V_REPETIR(cone->origemX), oy = V_REPETIR(cone->origemY);
+    const VetorF ex = V_REPETIR(cone->eixoX), ey = V_REPETIR(cone->eixoY);
+    const VetorF cosMeia = V_REPETIR(cone->cosMeia);
+    const VetorF sinMeia = V_REPETIR(cone->sinMeia), raio = V_REPETIR(cone->raio);
+    const VetorF sinMeia2Largo = V_REPETIR(cone->sinMeia2Largo);
+    const VetorF r2 = V_REPETIR(cone->raio2), limite2 = V_REPETIR(cone->limite2);
+    const VetorF zero = V_REPETIR(0.0f);
+    for (; i + LARGURA_SIMD <= n; i += LARGURA_SIMD) {
+        VetorF dx = V_SUBTRAIR(V_CARREGAR(x + i), ox);
+        VetorF dy = V_SUBTRAIR(V_CARREGAR(y + i), oy);
+        VetorF d2 = V_SOMAR(V_MULTIPLICAR(dx, dx), V_MULTIPLICAR(dy, dy));
+        VetorF projecao = V_SOMAR(V_MULTIPLICAR(dx, ex), V_MULTIPLICAR(dy, ey));
+        VetorF tangente = V_RAIZ(V_MAXIMO(V_SUBTRAIR(d2, r2), zero));
+        VetorF lateral = V_MULTIPLICAR(sinMeia, V_MINIMO(raio, V_RAIZ(d2)));
+        VetorF limiar = V_SUBTRAIR(V_MULTIPLICAR(cosMeia, tangente), lateral);
+        VetorF angulo = V_OU(V_MENOR_IGUAL(limiar, projecao),
+                             V_MENOR_IGUAL(V_MULTIPLICAR(sinMeia2Largo, d2), r2));
+        VetorF acerto = V_E(V_MENOR_IGUAL(d2, limite2), angulo);
+        acertos += EscreverMascara(mascara + i, V_BITS(acerto));
+    }
+#endif
+    for (; i < n; ++i) {
+        float dx = x[i] - cone->origemX;
+        float dy = y[i] - cone->origemY;
+        float d2 = dx * dx + dy * dy;
+        float projecao = dx * cone->eixoX + dy * cone->eixoY;
+        float resto = d2 - cone->raio2;
+        float distancia = sqrtf(d2);
+        float tangente = sqrtf(resto > 0.0f ? resto : 0.0f);
+        float lateral = cone->sinMeia * (cone->raio < distancia ? cone->raio : distancia);
+        float limiar = cone->cosMeia * tangente - lateral;
+        bool angulo = limiar <= projecao || cone->sinMeia2Largo * d2 <= cone->raio2;
+        mascara[i] = (uint8_t)(d2 <= cone->limite2 && angulo);
+        acertos += mascara[i];
+    }
+    return acertos;
+}
+
+// Distância² até o segmento do eixo da cápsula, nas mesmas contas do kernel
+static float DistanciaCapsula2(const CapsulaAcerto *capsula, float x, float y)
+{
+    float px = x - capsula->inicioX;
+    float py = y - capsula->inicioY;
+    float t = (px * capsula->segX + py * capsula->segY) * capsula->inversoComprimento2;
+    t = t > 0.0f ? t : 0.0f;
+    t = t < 1.0f ? t : 1.0f;
+    float dx = px - capsula->segX * t;
+    float dy = py - capsula->segY * t;
+    return dx * dx + dy * dy;
+}
+
+int TestesAcerto_Capsula(const float *x, const float *y, int n, const CapsulaAcerto *capsula,
+                         uint8_t *mascara)
+{
+    int acertos = 0;
+    int i = 0;
+#ifdef LARGURA_SIMD
+    const VetorF ax = V_REPETIR(capsula->inicioX), ay = V_REPETIR(capsula->inicioY);
+    const VetorF sx = V_REPETIR(capsula->segX), sy = V_REPETIR(capsula->segY);
+    const VetorF inverso = V_REPETIR(capsula->inversoComprimento2);
+    const VetorF r2 = V_REPETIR(capsula->raio2);
+    const VetorF zero = V_REPETIR(0.0f), um = V_REPETIR(1.0f);
+    for (; i + LARGURA_SIMD <= n; i += LARGURA_SIMD) {
+        VetorF px = V_SUBTRAIR(V_CARREGAR(x + i), ax);
+        VetorF py = V_SUBTRAIR(V_CARREGAR(y + i), ay);
+        VetorF t = V_MULTIPLICAR(V_SOMAR(V_MULTIPLICAR(px, sx), V_MULTIPLICAR(py, sy)), inverso);
+        t = V_MINIMO(V_MAXIMO(t, zero), um);
+        VetorF dx = V_SUBTRAIR(px, V_MULTIPLICAR(sx, t));
+        VetorF dy = V_SUBTRAIR(py, V_MULTIPLICAR(sy, t));
+        VetorF d2 = V_SOMAR(V_MULTIPLICAR(dx, dx), V_MULTIPLICAR(dy, dy));
+        acertos += EscreverMascara(mascara + i, V_BITS(V_MENOR_IGUAL(d2, r2)));
+    }
+#endif
+    for (; i < n; ++i) {
+        mascara[i] = (uint8_t)(DistanciaCapsula2(capsula, x[i], y[i]) <= capsula->raio2);
+        acertos += mascara[i];
+    }
+    return acertos;
+}
+
+float TestesAcerto_DistanciaSegmento2(Vector2 inicio, Vector2 fim, Vector2 ponto)
+{
+    CapsulaAcerto capsula = TestesAcerto_PrepararCapsula(inicio, fim, 0.0f);
+    return DistanciaCapsula2(&capsula, ponto.x, ponto.y);
+}
+
+const char *TestesAcerto_Implementacao(void)
+{
+    return IMPLEMENTACAO;
+}
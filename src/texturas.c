@@ -0,0 +1,293 @@
+#include "texturas.h"
+#include "perfil.h"
+#include "pacote.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TAMANHO_CAMINHO_TEXTURA 128
+// Borda em volta de cada sprite no atlas, preenchida com os pixels da
+// própria borda do sprite para que a amostragem nos cantos não puxe o vizinho
+#define ATLAS_BORDA 1
+
+typedef struct {
+    char caminho[TAMANHO_CAMINHO_TEXTURA];
+    unsigned int hash;
+    Texture2D textura;      // avulsa; sprites do atlas usam a página
+    Image imagem;           // pendente até Texturas_ConstruirAtlas
+    bool imagemDoPacote;    // aponta para o pacote mapeado: não descarregar
+    int pagina;             // -1 quando fora do atlas
+    Rectangle origem;
+    int referencias;
+} EntradaTextura;
+
+typedef struct {
+    EntradaTextura entradas[MAX_TEXTURAS_CACHE];
+    int quantidade;
+    Texture2D paginas[ATLAS_MAX_PAGINAS];
+    int quantidadePaginas;
+    bool atlasConstruido;
+    EstatisticasTexturas estatisticas;
+    bool inicializado;
+} CacheTexturas;
+
+static CacheTexturas gCache;
+
+#ifdef MTA_HEADLESS
+static bool gSemGPU = true;
+#else
+static bool gSemGPU = false;
+#endif
+
+static unsigned int HashCaminho(const char *caminho)
+{
+    // FNV-1a 32 bits
+    unsigned int hash = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)caminho; *p != '\0'; ++p) {
+        hash ^= *p;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static EntradaTextura *EntradaPorId(IdTextura id)
+{
+    if (id <= TEXTURA_NENHUMA || id > gCache.quantidade) return NULL;
+    return &gCache.entradas[id - 1];
+}
+
+bool Texturas_Inicializar(void)
+{
+    memset(&gCache, 0, sizeof(gCache));
+    gCache.inicializado = true;
+    return true;
+}
+
+void Texturas_Finalizar(void)
+{
+    for (int i = 0; i < gCache.quantidade; ++i) {
+        EntradaTextura *entrada = &gCache.entradas[i];
+        if (entrada->textura.id != 0) UnloadTexture(entrada->textura);
+        if (entrada->imagem.data && !entrada->imagemDoPacote) UnloadImage(entrada->imagem);
+    }
+    for (int p = 0; p < gCache.quantidadePaginas; ++p) {
+        UnloadTexture(gCache.paginas[p]);
+    }
+    memset(&gCache, 0, sizeof(gCache));
+}
+
+static void RegistrarBytesResidentes(Texture2D textura)
+{
+    if (textura.id == 0) return;
+    gCache.estatisticas.bytesResidentes +=
+        (size_t)GetPixelDataSize(textura.width, textura.height, textura.format);
+}
+
+IdTextura Texturas_Carregar(const char *caminho)
+{
+    if (!caminho || caminho[0] == '\0' || !gCache.inicializado) return TEXTURA_NENHUMA;
+
+    unsigned int hash = HashCaminho(caminho);
+    for (int i = 0; i < gCache.quantidade; ++i) {
+        EntradaTextura *entrada = &gCache.entradas[i];
+        if (entrada->hash == hash && strcmp(entrada->caminho, caminho) == 0) {
+            entrada->referencias++;
+            gCache.estatisticas.acertos++;
+            return i + 1;
+        }
+    }
+
+    gCache.estatisticas.falhas++;
+    if (gCache.quantidade >= MAX_TEXTURAS_CACHE) {
+        printf("Aviso: cache de texturas cheio, ignorando %s\n", caminho);
+        return TEXTURA_NENHUMA;
+    }
+    if (strlen(caminho) >= TAMANHO_CAMINHO_TEXTURA) {
+        printf("Aviso: caminho de textura muito longo: %s\n", caminho);
+        return TEXTURA_NENHUMA;
+    }
+
+    Texture2D textura = (Texture2D){0};
+    Image imagem = (Image){0};
+    Rectangle origem = (Rectangle){0};
+    bool imagemDoPacote = false;
+    if (!gSemGPU) {
+        double inicioCarga = PERFIL_AGORA();
+        // Pacote de assets primeiro (já decodificado); arquivo solto se não estiver lá
+        imagemDoPacote = Pacote_ObterImagem(caminho, &imagem);
+        if (gCache.atlasConstruido) {
+            textura = imagemDoPacote ? LoadTextureFromImage(imagem) : LoadTexture(caminho);
+            origem = (Rectangle){ 0.0f, 0.0f, (float)textura.width, (float)textura.height };
+            imagem = (Image){0};
+            imagemDoPacote = false;
+        } else {
+            if (!imagemDoPacote) imagem = LoadImage(caminho);
+            origem = (Rectangle){ 0.0f, 0.0f, (float)imagem.width, (float)imagem.height };
+        }
+        PERFIL_INTERVALO("Carregar textura", inicioCarga, gCache.quantidade + 1);
+        if (textura.id == 0 && imagem.data == NULL) return TEXTURA_NENHUMA;
+    }
+
+    EntradaTextura *nova = &gCache.entradas[gCache.quantidade++];
+    strcpy(nova->caminho, caminho);
+    nova->hash = hash;
+    nova->textura = textura;
+    nova->imagem = imagem;
+    nova->imagemDoPacote = imagemDoPacote;
+    nova->pagina = -1;
+    nova->origem = origem;
+    nova->referencias = 1;
+    gCache.estatisticas.texturasResidentes++;
+    RegistrarBytesResidentes(textura);
+    return gCache.quantidade;
+}
+
+static int CompararAlturaEntrada(const void *a, const void *b)
+{
+    const EntradaTextura *ea = &gCache.entradas[*(const int *)a];
+    const EntradaTextura *eb = &gCache.entradas[*(const int *)b];
+    if (ea->imagem.height != eb->imagem.height) return eb->imagem.height - ea->imagem.height;
+    return *(const int *)a - *(const int *)b;
+}
+
+// Copia a imagem para a página e repete as linhas/colunas da borda por fora dela
+static void DesenharNaPagina(Image *pagina, Image imagem, int x, int y)
+{
+    const float w = (float)imagem.width;
+    const float h = (float)imagem.height;
+    const float bx = (float)x;
+    const float by = (float)y;
+    const Color branco = WHITE;
+    ImageDraw(pagina, imagem, (Rectangle){ 0, 0, w, h }, (Rectangle){ bx, by, w, h }, branco);
+    for (int b = 1; b <= ATLAS_BORDA; ++b) {
+        ImageDraw(pagina, imagem, (Rectangle){ 0, 0, w, 1 }, (Rectangle){ bx, by - b, w, 1 }, branco);
+        ImageDraw(pagina, imagem, (Rectangle){ 0, h - 1, w, 1 }, (Rectangle){ bx, by + h - 1 + b, w, 1 }, branco);
+        ImageDraw(pagina, imagem, (Rectangle){ 0, 0, 1, h }, (Rectangle){ bx - b, by, 1, h }, branco);
+        ImageDraw(pagina, imagem, (Rectangle){ w - 1, 0, 1, h }, (Rectangle){ bx + w - 1 + b, by, 1, h }, branco);
+    }
+}
+
+bool Texturas_ConstruirAtlas(void)
+{
+    if (!gCache.inicializado || gCache.atlasConstruido) return false;
+    gCache.atlasConstruido = true;
+    if (gSemGPU) return true;
+
+    // Empacotamento em prateleiras: mais altas primeiro, da esquerda para a
+    // direita, abrindo uma prateleira nova (e uma página nova) quando não cabe.
+    int ordem[MAX_TEXTURAS_CACHE];
+    int pendentes = 0;
+    for (int i = 0; i < gCache.quantidade; ++i) {
+        if (gCache.entradas[i].imagem.data) ordem[pendentes++] = i;
+    }
+    qsort(ordem, (size_t)pendentes, sizeof(int), CompararAlturaEntrada);
+
+    const int tamanho = ATLAS_TAMANHO_PAGINA;
+    int alturaUsada[ATLAS_MAX_PAGINAS] = {0};
+    int pagina = 0, x = 0, y = 0, alturaPrateleira = 0;
+    for (int k = 0; k < pendentes; ++k) {
+        EntradaTextura *entrada = &gCache.entradas[ordem[k]];
+        int w = entrada->imagem.width + ATLAS_BORDA * 2;
+        int h = entrada->imagem.height + ATLAS_BORDA * 2;
+        if (w > tamanho || h > tamanho) continue;
+        if (x + w > tamanho) {
+            x = 0;
+            y += alturaPrateleira;
+            alturaPrateleira = 0;
+        }
+        if (y + h > tamanho) {
+            if (pagina + 1 >= ATLAS_MAX_PAGINAS) continue;
+            pagina++;
+            x = 0;
+            y = 0;
+            alturaPrateleira = 0;
+        }
+        entrada->pagina = pagina;
+        entrada->origem = (Rectangle){ (float)(x + ATLAS_BORDA), (float)(y + ATLAS_BORDA),
+                                       (float)entrada->imagem.width, (float)entrada->imagem.height };
+        x += w;
+        if (h > alturaPrateleira) alturaPrateleira = h;
+        if (y + alturaPrateleira > alturaUsada[pagina]) alturaUsada[pagina] = y + alturaPrateleira;
+    }
+    int paginasUsadas = (pendentes > 0) ? pagina + 1 : 0;
+
+    bool sucesso = true;
+    for (int p = 0; p < paginasUsadas; ++p) {
+        Image imagemPagina = GenImageColor(tamanho, alturaUsada[p], BLANK);
+        for (int k = 0; k < pendentes; ++k) {
+            EntradaTextura *entrada = &gCache.entradas[ordem[k]];
+            if (entrada->pagina != p) continue;
+            DesenharNaPagina(&imagemPagina, entrada->imagem,
+                             (int)entrada->origem.x, (int)entrada->origem.y);
+        }
+        Texture2D texturaPagina = LoadTextureFromImage(imagemPagina);
+        UnloadImage(imagemPagina);
+        if (texturaPagina.id == 0) {
+            printf("Erro: nao foi possivel enviar a pagina %d do atlas\n", p);
+            sucesso = false;
+        }
+        gCache.paginas[p] = texturaPagina;
+        gCache.quantidadePaginas = p + 1;
+        RegistrarBytesResidentes(texturaPagina);
+    }
+
+    for (int k = 0; k < pendentes; ++k) {
+        EntradaTextura *entrada = &gCache.entradas[ordem[k]];
+        if (entrada->pagina >= 0) {
+            gCache.estatisticas.spritesNoAtlas++;
+        } else {
+            // Grande demais ou sem páginas livres: fica avulsa
+            entrada->textura = LoadTextureFromImage(entrada->imagem);
+            entrada->origem = (Rectangle){ 0.0f, 0.0f, (float)entrada->imagem.width, (float)entrada->imagem.height };
+            RegistrarBytesResidentes(entrada->textura);
+        }
+        if (!entrada->imagemDoPacote) UnloadImage(entrada->imagem);
+        entrada->imagem = (Image){0};
+        entrada->imagemDoPacote = false;
+    }
+    gCache.estatisticas.paginasAtlas = gCache.quantidadePaginas;
+    return sucesso;
+}
+
+void Texturas_DefinirSemGPU(bool semGPU)
+{
+    gSemGPU = semGPU;
+}
+
+void Texturas_Liberar(IdTextura id)
+{
+    EntradaTextura *entrada = EntradaPorId(id);
+    if (!entrada || entrada->referencias <= 0) return;
+    // A textura continua residente mesmo sem referencias: o descarregamento
+    // acontece apenas em Texturas_Finalizar para evitar recarregar a cada spawn.
+    entrada->referencias--;
+}
+
+SpriteTextura Texturas_ObterSprite(IdTextura id)
+{
+    EntradaTextura *entrada = EntradaPorId(id);
+    if (!entrada) return (SpriteTextura){0};
+    SpriteTextura sprite;
+    sprite.textura = (entrada->pagina >= 0) ? gCache.paginas[entrada->pagina] : entrada->textura;
+    sprite.origem = entrada->origem;
+    return sprite;
+}
+
+Vector2 Texturas_Tamanho(IdTextura id)
+{
+    EntradaTextura *entrada = EntradaPorId(id);
+    if (!entrada) return (Vector2){0};
+    return (Vector2){ entrada->origem.width, entrada->origem.height };
+}
+
+void Texturas_DesenharSprite(SpriteTextura sprite, Vector2 posicao, float escala, Color cor)
+{
+    if (sprite.textura.id == 0) return;
+    Rectangle destino = { posicao.x, posicao.y, sprite.origem.width * escala, sprite.origem.height * escala };
+    DrawTexturePro(sprite.textura, sprite.origem, destino, (Vector2){ 0.0f, 0.0f }, 0.0f, cor);
+}
+
+EstatisticasTexturas Texturas_Estatisticas(void)
+{
+    return gCache.estatisticas;
+}
@@ -78,13 +78,12 @@ void UI_DesenharPersonagemPreview(const Jogador *jogadorBase,
 {
     if (!jogadorBase) return;
     if (escala <= 0.0f) escala = 1.0f;
-    const Texture2D sprite = jogadorBase->parado;
-    DrawTextureEx(sprite,
-                  (Vector2){ posicaoCentro.x - (sprite.width * escala) / 2.0f,
-                             posicaoCentro.y - (sprite.height * escala) / 2.0f },
-                  0.0f,
-                  escala,
-                  WHITE);
+    const SpriteTextura sprite = Texturas_ObterSprite(jogadorBase->parado);
+    Texturas_DesenharSprite(sprite,
+                            (Vector2){ posicaoCentro.x - (sprite.origem.width * escala) / 2.0f,
+                                       posicaoCentro.y - (sprite.origem.height * escala) / 2.0f },
+                            escala,
+                            WHITE);
 
     if (cap) DesenharCapacete(cap, posicaoCentro, escala);
     if (arm) DesenharArmadura(arm, posicaoCentro, false, false, escala);
@@ -0,0 +1,174 @@
+// Empacotador offline de assets: decodifica PNGs e rasteriza TTFs uma vez e
+// grava tudo num único arquivo (formato descrito em include/pacote.h).
+// Uso: make pacote  (ou ./bin/empacotar_assets assets.pak arquivo1 arquivo2 ...)
+// As chaves do diretório são os caminhos exatamente como passados, que devem
+// ser os mesmos usados pelo jogo (ex.: assets/tiles/rua.png).
+#include "raylib.h"
+#include "pacote.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Os mesmos parâmetros que LoadFont usa para TTF
+#define FONTE_TAMANHO_BASE 32
+#define FONTE_QUANTIDADE_GLIFOS 95
+#define FONTE_PADDING_GLIFOS 4
+#define ALINHAMENTO_DADOS 16
+
+typedef struct {
+    const char *caminho;
+    TipoAssetPacote tipo;
+    Image imagem;               // pixels (nas fontes, o atlas de glifos)
+    GlyphInfo *glifos;
+    Rectangle *retangulos;
+    int quantidadeGlifos;
+    uint32_t offset;
+    uint32_t tamanho;
+} AssetPacote;
+
+static void EscreverU16(unsigned char *p, uint16_t v)
+{
+    p[0] = (unsigned char)(v & 0xFF);
+    p[1] = (unsigned char)(v >> 8);
+}
+
+static void EscreverU32(unsigned char *p, uint32_t v)
+{
+    for (int i = 0; i < 4; ++i) p[i] = (unsigned char)(v >> (8 * i));
+}
+
+static void EscreverF32(unsigned char *p, float f)
+{
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    EscreverU32(p, bits);
+}
+
+static bool TerminaCom(const char *texto, const char *sufixo)
+{
+    size_t n = strlen(texto), m = strlen(sufixo);
+    return n >= m && strcmp(texto + n - m, sufixo) == 0;
+}
+
+static bool CarregarAsset(AssetPacote *asset)
+{
+    if (TerminaCom(asset->caminho, ".ttf") || TerminaCom(asset->caminho, ".otf")) {
+        int tamanhoArquivo = 0;
+        unsigned char *arquivo = LoadFileData(asset->caminho, &tamanhoArquivo);
+        if (!arquivo) return false;
+        asset->tipo = PACOTE_ASSET_FONTE;
+        asset->quantidadeGlifos = FONTE_QUANTIDADE_GLIFOS;
+        asset->glifos = LoadFontData(arquivo, tamanhoArquivo, FONTE_TAMANHO_BASE, NULL,
+                                     FONTE_QUANTIDADE_GLIFOS, FONT_DEFAULT);
+        UnloadFileData(arquivo);
+        if (!asset->glifos) return false;
+        asset->imagem = GenImageFontAtlas(asset->glifos, &asset->retangulos, asset->quantidadeGlifos,
+                                          FONTE_TAMANHO_BASE, FONTE_PADDING_GLIFOS, 0);
+        return asset->imagem.data != NULL;
+    }
+
+    asset->tipo = PACOTE_ASSET_IMAGEM;
+    asset->imagem = LoadImage(asset->caminho);
+    if (!asset->imagem.data) return false;
+    // O atlas de texturas é RGBA8; converter aqui evita a conversão na carga
+    ImageFormat(&asset->imagem, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    return true;
+}
+
+static uint32_t BytesPixels(const AssetPacote *asset)
+{
+    return (uint32_t)GetPixelDataSize(asset->imagem.width, asset->imagem.height, asset->imagem.format);
+}
+
+static bool GravarPacote(const char *saida, AssetPacote *assets, int quantidade)
+{
+    uint32_t offset = PACOTE_TAMANHO_CABECALHO + (uint32_t)quantidade * PACOTE_TAMANHO_ENTRADA;
+    for (int i = 0; i < quantidade; ++i) {
+        offset = (offset + ALINHAMENTO_DADOS - 1) & ~(uint32_t)(ALINHAMENTO_DADOS - 1);
+        assets[i].offset = offset;
+        assets[i].tamanho = BytesPixels(&assets[i]) +
+                            (uint32_t)assets[i].quantidadeGlifos * PACOTE_TAMANHO_GLIFO;
+        offset += assets[i].tamanho;
+    }
+
+    unsigned char *dados = calloc(offset, 1);
+    if (!dados) return false;
+
+    memcpy(dados, "MTAP", 4);
+    EscreverU16(dados + 4, PACOTE_VERSAO);
+    EscreverU32(dados + 8, (uint32_t)quantidade);
+
+    for (int i = 0; i < quantidade; ++i) {
+        const AssetPacote *a = &assets[i];
+        unsigned char *e = dados + PACOTE_TAMANHO_CABECALHO + (size_t)i * PACOTE_TAMANHO_ENTRADA;
+        strcpy((char *)e, a->caminho);
+        EscreverU16(e + 96, (uint16_t)a->tipo);
+        EscreverU16(e + 98, a->tipo == PACOTE_ASSET_FONTE ? FONTE_PADDING_GLIFOS : 0);
+        EscreverU32(e + 100, (uint32_t)a->imagem.width);
+        EscreverU32(e + 104, (uint32_t)a->imagem.height);
+        EscreverU32(e + 108, (uint32_t)a->imagem.format);
+        EscreverU32(e + 112, a->offset);
+        EscreverU32(e + 116, a->tamanho);
+        EscreverU32(e + 120, a->tipo == PACOTE_ASSET_FONTE ? FONTE_TAMANHO_BASE : 0);
+        EscreverU32(e + 124, (uint32_t)a->quantidadeGlifos);
+
+        unsigned char *p = dados + a->offset;
+        memcpy(p, a->imagem.data, BytesPixels(a));
+        p += BytesPixels(a);
+        for (int g = 0; g < a->quantidadeGlifos; ++g, p += PACOTE_TAMANHO_GLIFO) {
+            EscreverU32(p, (uint32_t)a->glifos[g].value);
+            EscreverU32(p + 4, (uint32_t)a->glifos[g].offsetX);
+            EscreverU32(p + 8, (uint32_t)a->glifos[g].offsetY);
+            EscreverU32(p + 12, (uint32_t)a->glifos[g].advanceX);
+            EscreverF32(p + 16, a->retangulos[g].x);
+            EscreverF32(p + 20, a->retangulos[g].y);
+            EscreverF32(p + 24, a->retangulos[g].width);
+            EscreverF32(p + 28, a->retangulos[g].height);
+        }
+    }
+
+    FILE *arquivo = fopen(saida, "wb");
+    bool sucesso = arquivo && fwrite(dados, 1, offset, arquivo) == offset;
+    if (arquivo) fclose(arquivo);
+    free(dados);
+    if (sucesso) printf("%s: %d assets, %.1f KiB\n", saida, quantidade, offset / 1024.0);
+    return sucesso;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3) {
+        printf("Uso: %s saida.pak arquivo.png|arquivo.ttf...\n", argv[0]);
+        return 1;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+
+    int quantidade = argc - 2;
+    AssetPacote *assets = calloc((size_t)quantidade, sizeof(AssetPacote));
+    if (!assets) return 1;
+
+    int codigo = 0;
+    for (int i = 0; i < quantidade && codigo == 0; ++i) {
+        assets[i].caminho = argv[i + 2];
+        if (strlen(assets[i].caminho) >= PACOTE_TAMANHO_CAMINHO) {
+            printf("Erro: caminho muito longo para o pacote: %s\n", assets[i].caminho);
+            codigo = 1;
+        } else if (!CarregarAsset(&assets[i])) {
+            printf("Erro: nao foi possivel carregar %s\n", assets[i].caminho);
+            codigo = 1;
+        }
+    }
+    if (codigo == 0 && !GravarPacote(argv[1], assets, quantidade)) {
+        printf("Erro: nao foi possivel gravar %s\n", argv[1]);
+        codigo = 1;
+    }
+
+    for (int i = 0; i < quantidade; ++i) {
+        if (assets[i].imagem.data) UnloadImage(assets[i].imagem);
+        if (assets[i].glifos) UnloadFontData(assets[i].glifos, assets[i].quantidadeGlifos);
+        RL_FREE(assets[i].retangulos);
+    }
+    free(assets);
+    return codigo;
+}